@@ -0,0 +1,150 @@
+#pragma once
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstddef>
+#include <cstdio>
+#include <functional>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+namespace hz::bench {
+    using milliseconds = std::chrono::duration<double, std::milli>;
+
+    // What a repetition runs: prepare, untimed, then run, timed. Benchmarks that change their state, like advancing a
+    // scene, restore it in prepare so that every repetition times the same work
+    struct timed_function {
+        template<typename Run>
+        timed_function(Run run)
+            : run(std::move(run)) {
+
+        }
+
+        template<typename Prepare, typename Run>
+        timed_function(Prepare prepare, Run run)
+            : prepare(std::move(prepare))
+            , run(std::move(run)) {
+
+        }
+
+        std::function<void()> prepare;
+        std::function<void()> run;
+    };
+
+    // A benchmark is set up only when it is selected, since the large scenes take a while to build and a lot of memory.
+    // setup returns the function timed on each repetition, which owns whatever state it needs. The note, if any, is
+    // printed next to the timings
+    struct benchmark {
+        std::string name;
+        std::size_t items;
+        std::function<timed_function()> setup;
+        std::string note;
+    };
+
+    // With fewer than a hundred repetitions the nearest rank p99 is the slowest repetition, and is labelled as the max
+    struct settings {
+        int warmup = 2;
+        int repetitions = 10;
+    };
+
+    struct result {
+        std::string name;
+        std::size_t items;
+        std::string note;
+        int repetitions;
+        milliseconds min;
+        milliseconds median;
+        milliseconds p99;
+        milliseconds mean;
+    };
+
+    class registry {
+    public:
+        template<typename Setup>
+        void add(std::string name, std::size_t items, Setup && setup, std::string note = {}) {
+            benchmarks.push_back({std::move(name), items, std::forward<Setup>(setup), std::move(note)});
+        }
+
+        auto get_benchmarks() const noexcept -> std::vector<benchmark> const& {
+            return benchmarks;
+        }
+
+    private:
+        std::vector<benchmark> benchmarks;
+    };
+
+    // Registered by each benchmark file
+    void add_integration_benchmarks(registry & r);
+    void add_integrate_benchmarks(registry & r);
+    void add_update_entities_benchmarks(registry & r);
+    void add_render_entities_benchmarks(registry & r);
+
+    // Nearest rank percentile of sorted samples
+    inline auto percentile(std::vector<milliseconds> const& sorted, double p) -> milliseconds {
+        auto const rank = static_cast<std::size_t>(std::ceil(p / 100.0 * static_cast<double>(sorted.size())));
+        return sorted[std::clamp<std::size_t>(rank, 1, sorted.size()) - 1];
+    }
+
+    inline auto run(benchmark const& b, settings const& s) -> result {
+        auto const f = b.setup();
+        auto const repeat = [&f] {
+            if(f.prepare) {
+                f.prepare();
+            }
+            auto const start = std::chrono::steady_clock::now();
+            f.run();
+            return milliseconds(std::chrono::steady_clock::now() - start);
+        };
+        for(int i = 0; i < s.warmup; ++i) {
+            repeat();
+        }
+
+        auto samples = std::vector<milliseconds>();
+        samples.reserve(static_cast<std::size_t>(s.repetitions));
+        for(int i = 0; i < s.repetitions; ++i) {
+            samples.push_back(repeat());
+        }
+        std::sort(samples.begin(), samples.end());
+
+        auto total = milliseconds();
+        for(auto const sample : samples) {
+            total += sample;
+        }
+        return {b.name, b.items, b.note, s.repetitions, samples.front(), percentile(samples, 50.0), percentile(samples, 99.0), total / s.repetitions};
+    }
+
+    inline void print_header(settings const& s) {
+        std::printf("%-44s %10s %12s %12s %12s %14s\n", "benchmark", "items", "min ms", "median ms", s.repetitions < 100 ? "max ms" : "p99 ms", "ns/item");
+    }
+
+    inline void print_result(result const& r) {
+        std::printf("%-44s %10zu %12.4f %12.4f %12.4f %14.3f%s%s\n", r.name.c_str(), r.items, r.min.count(), r.median.count(), r.p99.count(),
+            r.median.count() * 1e6 / static_cast<double>(std::max<std::size_t>(r.items, 1)), r.note.empty() ? "" : "  ", r.note.c_str());
+        std::fflush(stdout);
+    }
+
+    // Benchmark names only use [a-z0-9_/] and notes no quotes or backslashes, so need no escaping
+    inline void write_json(std::FILE * out, std::vector<result> const& results) {
+        std::fprintf(out, "{\n  \"benchmarks\": [");
+        for(std::size_t i = 0; i < results.size(); ++i) {
+            auto const& r = results[i];
+            std::fprintf(out, "%s\n    {\"name\": \"%s\", \"items\": %zu, \"repetitions\": %d, \"min_ms\": %.6f, \"median_ms\": %.6f, \"p99_ms\": %.6f, \"mean_ms\": %.6f, \"note\": \"%s\"}",
+                i == 0 ? "" : ",", r.name.c_str(), r.items, r.repetitions, r.min.count(), r.median.count(), r.p99.count(), r.mean.count(), r.note.c_str());
+        }
+        std::fprintf(out, "\n  ]\n}\n");
+    }
+
+    // Keeps results the optimizer could otherwise prove unused
+    template<typename T>
+    inline void do_not_optimize(T const& value) {
+#if defined(__GNUC__)
+        asm volatile("" : : "r"(&value) : "memory");
+#else
+        auto const* volatile sink = &value;
+        (void)sink;
+#endif
+    }
+}
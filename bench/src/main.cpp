@@ -0,0 +1,93 @@
+#include <cstdio>
+#include <cstdlib>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "harness.h"
+
+namespace {
+    auto parse_count(char const* text, int & value) -> bool {
+        char * end = nullptr;
+        auto const parsed = std::strtol(text, &end, 10);
+        if(end == text || *end != '\0' || parsed < 0) {
+            return false;
+        }
+        value = static_cast<int>(parsed);
+        return true;
+    }
+}
+
+// Runs every benchmark whose name contains the filter, printing a table and optionally writing JSON to a file or,
+// with "-", to stdout instead of the table. The JSON always names the 99th percentile p99, which below a hundred
+// repetitions is the slowest repetition
+auto main(int argc, char* argv[]) -> int {
+    auto settings = hz::bench::settings();
+    auto filter = std::string_view();
+    auto json_path = std::string();
+    auto list_only = false;
+
+    auto valid = true;
+    for(int i = 1; i < argc && valid; ++i) {
+        auto const arg = std::string_view(argv[i]);
+        auto const has_value = i + 1 < argc;
+        if(arg == "--list") {
+            list_only = true;
+        } else if(arg == "--filter" && has_value) {
+            filter = argv[++i];
+        } else if(arg == "--json" && has_value) {
+            json_path = argv[++i];
+        } else if(arg == "--warmup" && has_value) {
+            valid = parse_count(argv[++i], settings.warmup);
+        } else if(arg == "--repetitions" && has_value) {
+            valid = parse_count(argv[++i], settings.repetitions) && settings.repetitions > 0;
+        } else {
+            valid = false;
+        }
+    }
+    if(!valid) {
+        std::fprintf(stderr, "Usage: %s [--list] [--filter <substring>] [--warmup <count>] [--repetitions <count>] [--json <file | ->]\n", argv[0]);
+        return 1;
+    }
+
+    auto registry = hz::bench::registry();
+    hz::bench::add_integration_benchmarks(registry);
+    hz::bench::add_integrate_benchmarks(registry);
+    hz::bench::add_update_entities_benchmarks(registry);
+#if !defined(AGEA_HEADLESS)
+    hz::bench::add_render_entities_benchmarks(registry);
+#endif
+
+    auto const table = json_path != "-";
+    if(table && !list_only) {
+        hz::bench::print_header(settings);
+    }
+    auto results = std::vector<hz::bench::result>();
+    for(auto const& b : registry.get_benchmarks()) {
+        if(b.name.find(filter) == std::string::npos) {
+            continue;
+        }
+        if(list_only) {
+            std::printf("%s\n", b.name.c_str());
+            continue;
+        }
+        results.push_back(hz::bench::run(b, settings));
+        if(table) {
+            hz::bench::print_result(results.back());
+        }
+    }
+
+    if(json_path.empty() || list_only) {
+        return 0;
+    }
+    auto * const out = json_path == "-" ? stdout : std::fopen(json_path.c_str(), "w");
+    if(out == nullptr) {
+        std::fprintf(stderr, "Unable to write %s\n", json_path.c_str());
+        return 1;
+    }
+    hz::bench::write_json(out, results);
+    if(out != stdout) {
+        std::fclose(out);
+    }
+    return 0;
+}
@@ -0,0 +1,56 @@
+#include <cmath>
+#include <cstddef>
+#include <cstdio>
+#include <string>
+#include <tuple>
+#include <utility>
+
+#include <math/integration.h>
+
+#include "../harness.h"
+
+namespace hz::bench {
+    namespace {
+        auto constexpr pi = 3.14159265358979323846;
+
+        // Unit harmonic oscillator x'' = -x from x = 1, v = 0, over one period of n steps
+        template<typename Integrator>
+        auto oscillate(double start_x, int n) -> std::pair<double, double> {
+            auto const h = 2.0 * pi / n;
+            auto const spring = [] (double, double x, double) { return -x; };
+            auto x = start_x;
+            auto v = 0.0;
+            for(int i = 0; i < n; ++i) {
+                std::tie(x, v) = Integrator::step(x, v, spring, i * h, h);
+            }
+            return {x, v};
+        }
+
+        // Times one period at each step count, noting the error after it, to weigh each scheme's accuracy against its cost
+        template<typename Integrator>
+        void add_scheme(registry & r, char const* scheme) {
+            for(int const steps : {16, 64, 256}) {
+                auto const [x, v] = oscillate<Integrator>(1.0, steps);
+                char note[32];
+                std::snprintf(note, sizeof(note), "error %.3e", std::abs(x - 1.0) + std::abs(v));
+
+                r.add(std::string("math/integration/") + scheme + "/" + std::to_string(steps), static_cast<std::size_t>(steps), [steps] {
+                    return [steps] {
+                        // Read back through a volatile so that the period can be neither hoisted nor dropped
+                        auto volatile start_x = 1.0;
+                        auto const result = oscillate<Integrator>(start_x, steps);
+                        do_not_optimize(result);
+                    };
+                }, note);
+            }
+        }
+    }
+
+    void add_integration_benchmarks(registry & r) {
+        add_scheme<math::euler>(r, "euler");
+        add_scheme<math::velocity_verlet>(r, "velocity_verlet");
+        add_scheme<math::rk2>(r, "rk2");
+        add_scheme<math::rk4>(r, "rk4");
+        add_scheme<math::yoshida4>(r, "yoshida4");
+    }
+}
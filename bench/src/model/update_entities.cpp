@@ -0,0 +1,102 @@
+#include <cstddef>
+#include <memory>
+#include <string>
+#include <utility>
+
+#include <common/thread/job_pool.h>
+#include <input/event.h>
+#include <model/simulation.h>
+
+#include "../harness.h"
+
+namespace hz::bench {
+    namespace {
+        // Velocity dependent, so its cost grows with the body's state rather than being a constant force
+        struct drag_component {
+            void on_update(model::entity & entity) {
+                entity.body.add_force(physics::force2d(entity.body.velocity().value * -drag));
+            }
+
+            double drag = 0.1;
+        };
+
+        struct timer_component {
+            void on_update(model::entity &, input::event_state_t const&, physics::seconds dt) {
+                elapsed += dt;
+            }
+
+            physics::seconds elapsed = {};
+        };
+
+        enum class component_mix {
+            // Every box falls under gravity_component, as in the demo scene
+            gravity,
+            // No components at all, so only the physics runs
+            bare,
+            // Gravity on every box, drag on every other one and a timer on every fourth, spread over four archetypes
+            mixed,
+        };
+
+        auto make_scene(std::size_t count, component_mix mix) -> model::game_model {
+            switch(mix) {
+                case component_mix::bare:
+                    return model::init_model(count, [] (std::size_t) { return model::entity(); });
+                case component_mix::mixed:
+                    return model::init_model(count, [] (std::size_t i) {
+                        auto box = model::entity();
+                        box.components.push_back(model::gravity_component());
+                        if(i % 2 == 0) box.components.push_back(drag_component());
+                        if(i % 4 == 0) box.components.push_back(timer_component());
+                        return box;
+                    });
+                case component_mix::gravity:
+                    break;
+            }
+            return model::init_model(count);
+        }
+
+        auto constexpr ticks_per_repetition = 10;
+
+        // The scene with a fresh snapshot buffer, since advance_tick does not publish
+        auto copy_scene(model::game_model const& scene) -> model::game_model {
+            return model::game_model{scene.model, scene.collisions, scene.sleeping, std::make_unique<model::snapshot_buffer>(), scene.checksums, scene.tick};
+        }
+
+        // Each repetition restarts from a copy of the set up scene, made before timing, and times its first ticks, so
+        // that every repetition does the same work. Items count each box once per tick
+        void add_scene(registry & r, char const* mix_name, component_mix mix, std::size_t count) {
+            r.add(std::string("model/update_entities/") + mix_name + "/" + std::to_string(count), count * ticks_per_repetition, [count, mix] {
+                struct state {
+                    explicit state(model::game_model scene)
+                        : initial(std::move(scene))
+                        , current(copy_scene(initial))
+                        , pool(model::default_worker_count()) {
+
+                    }
+
+                    model::game_model initial;
+                    model::game_model current;
+                    thread::job_pool pool;
+                };
+                auto const s = std::make_shared<state>(make_scene(count, mix));
+                return timed_function([s] {
+                    s->current = copy_scene(s->initial);
+                }, [s] {
+                    for(int i = 0; i < ticks_per_repetition; ++i) {
+                        model::advance_tick(s->current, s->pool, input::event_state_t(), model::tick_duration);
+                    }
+                });
+            });
+        }
+    }
+
+    void add_update_entities_benchmarks(registry & r) {
+        for(std::size_t const count : {std::size_t(1000), std::size_t(100000), std::size_t(1000000)}) {
+            add_scene(r, "gravity", component_mix::gravity, count);
+        }
+        for(std::size_t const count : {std::size_t(1000), std::size_t(100000)}) {
+            add_scene(r, "bare", component_mix::bare, count);
+            add_scene(r, "mixed", component_mix::mixed, count);
+        }
+    }
+}
@@ -0,0 +1,71 @@
+#include <cstddef>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include <physics/body.h>
+#include <physics/integrate_batch.h>
+
+#include "../harness.h"
+
+namespace hz::bench {
+    namespace {
+        auto constexpr dt = physics::seconds(1.0 / 60.0);
+
+        template<typename T>
+        auto make_bodies(std::size_t count) -> std::vector<physics::basic_body2d<T>> {
+            auto bodies = std::vector<physics::basic_body2d<T>>(count);
+            for(std::size_t i = 0; i < count; ++i) {
+                bodies[i].velocity = physics::basic_velocity2d<T>(T(1), T(i % 7));
+                bodies[i].acceleration = physics::basic_acceleration2d<T>(T(0), T(-10));
+            }
+            return bodies;
+        }
+
+        template<typename T>
+        struct soa_columns {
+            explicit soa_columns(std::size_t count)
+                : positions(count)
+                , velocities(count, physics::basic_velocity2d<T>(T(1), T(2)))
+                , accelerations(count, physics::basic_acceleration2d<T>(T(0), T(-10))) {
+
+            }
+
+            std::vector<physics::basic_position2d<T>> positions;
+            std::vector<physics::basic_velocity2d<T>> velocities;
+            std::vector<physics::basic_acceleration2d<T>> accelerations;
+        };
+    }
+
+    void add_integrate_benchmarks(registry & r) {
+        for(std::size_t const count : {std::size_t(1000), std::size_t(100000), std::size_t(1000000)}) {
+            auto const suffix = "/" + std::to_string(count);
+
+            r.add("physics/integrate" + suffix, count, [count] {
+                auto bodies = std::make_shared<std::vector<physics::body2d>>(make_bodies<double>(count));
+                return [bodies] {
+                    for(auto & b : *bodies) {
+                        b = physics::integrate(b, dt);
+                    }
+                    do_not_optimize(bodies->back());
+                };
+            });
+
+            r.add("physics/integrate_batch/double" + suffix, count, [count] {
+                auto columns = std::make_shared<soa_columns<double>>(count);
+                return [columns] {
+                    physics::integrate_batch(columns->positions, columns->velocities, range::contiguous_view<physics::acceleration2d const>(columns->accelerations), dt);
+                    do_not_optimize(columns->positions.back());
+                };
+            });
+
+            r.add("physics/integrate_batch/float" + suffix, count, [count] {
+                auto columns = std::make_shared<soa_columns<float>>(count);
+                return [columns] {
+                    physics::integrate_batch(columns->positions, columns->velocities, range::contiguous_view<physics::basic_acceleration2d<float> const>(columns->accelerations), dt);
+                    do_not_optimize(columns->positions.back());
+                };
+            });
+        }
+    }
+}
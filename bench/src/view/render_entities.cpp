@@ -0,0 +1,64 @@
+#include <cmath>
+#include <cstddef>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include <SDL.h>
+
+#include <model/simulation.h>
+#include <view/sdl/render.h>
+#include <view/sdl/sdl.h>
+
+#include "../harness.h"
+
+namespace hz::bench {
+    namespace {
+        namespace sdl = view::sdl;
+
+        // Renders into a software surface, so no window or video subsystem is needed
+        struct render_scene {
+            sdl::unique_surface surface;
+            sdl::unique_renderer renderer;
+            std::vector<sdl::view_entity_t> view_entities;
+            model::body_snapshot snapshot;
+        };
+
+        auto make_render_scene(std::size_t count) -> std::shared_ptr<render_scene> {
+            auto scene = std::make_shared<render_scene>();
+            scene->surface = sdl::unique_surface(SDL_CreateRGBSurfaceWithFormat(0, sdl::window_x, sdl::window_y, 32, SDL_PIXELFORMAT_RGBA8888));
+            scene->renderer = sdl::unique_renderer(SDL_CreateSoftwareRenderer(scene->surface.get()));
+
+            // Spread over the view, so that every copy lands on screen
+            auto const columns = static_cast<std::size_t>(std::ceil(std::sqrt(static_cast<double>(count))));
+            for(std::size_t i = 0; i < count; ++i) {
+                auto texture = sdl::generate_white_texture(*scene->renderer, 1, 1);
+                if(!texture) {
+                    break;
+                }
+                scene->view_entities.push_back({std::move(texture).value(), i});
+
+                auto const position = physics::basic_position2d<float>(
+                    static_cast<float>((static_cast<double>(i % columns) / columns - 0.5) * sdl::camera_world_x),
+                    static_cast<float>((static_cast<double>(i / columns) / columns - 0.5) * sdl::camera_world_y));
+                scene->snapshot.previous_positions.push_back(position);
+                scene->snapshot.positions.push_back(position);
+                scene->snapshot.dimensions.push_back({1.0f, 1.0f});
+            }
+            return scene;
+        }
+    }
+
+    // One texture per entity as in the game, so a million entities would mean a million textures; the largest scene is
+    // kept at 100k
+    void add_render_entities_benchmarks(registry & r) {
+        for(std::size_t const count : {std::size_t(1000), std::size_t(100000)}) {
+            r.add("view/render_entities/" + std::to_string(count), count, [count] {
+                auto scene = make_render_scene(count);
+                return [scene] {
+                    sdl::render_entities(scene->view_entities, scene->snapshot, 0.5, *scene->renderer);
+                };
+            });
+        }
+    }
+}
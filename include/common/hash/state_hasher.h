@@ -0,0 +1,208 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <optional>
+#include <type_traits>
+#include <vector>
+
+#if defined(__AVX2__)
+#include <immintrin.h>
+#elif defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define HZ_HASH_SSE2 1
+#endif
+
+#include <gsl/gsl_assert>
+
+#include "common/range/view.h"
+
+namespace hz::hash {
+    // Fast non-cryptographic hash over 64 bit words, for spotting divergence between runs rather than for hash tables.
+    // Words are spread over four lanes, each mixed with a 32x32 bit multiply of the word's halves as in XXH3, which maps
+    // to one SIMD multiply per register. Keys advance with every stripe of four words, so reordered words change the
+    // digest. The SIMD and scalar paths give the same digest, so machines with different instruction sets can compare
+    // checksums. Each update is padded to whole words
+    class state_hasher {
+    public:
+        explicit state_hasher(std::uint64_t seed = 0) noexcept {
+            for(std::size_t i = 0; i < lane_count; ++i) {
+                lanes[i] = seed ^ keys[i];
+            }
+        }
+
+        void update(void const* data, std::size_t bytes) noexcept {
+            auto const words = bytes / sizeof(std::uint64_t);
+            auto const* const bytes_in = static_cast<unsigned char const*>(data);
+
+            auto i = std::size_t(0);
+            // Lane of the next word, since the previous update may have ended mid stripe
+            for(; i < words && word_count % lane_count != 0; ++i) {
+                mix_word(load(bytes_in + i * sizeof(std::uint64_t)));
+            }
+            auto const stripes = (words - i) / lane_count;
+            mix_stripes(bytes_in + i * sizeof(std::uint64_t), stripes);
+            i += stripes * lane_count;
+            for(; i < words; ++i) {
+                mix_word(load(bytes_in + i * sizeof(std::uint64_t)));
+            }
+
+            if(auto const tail = bytes % sizeof(std::uint64_t); tail != 0) {
+                auto word = std::uint64_t(0);
+                std::memcpy(&word, bytes_in + words * sizeof(std::uint64_t), tail);
+                mix_word(word);
+            }
+            byte_count += bytes;
+        }
+
+        // Hashes the object representation, so padding bytes must be deterministic
+        template<typename T>
+        void update(range::contiguous_view<T const> column) noexcept {
+            static_assert(std::is_trivially_copyable_v<T>, "only trivially copyable columns can be hashed by their bytes");
+            update(column.data(), static_cast<std::size_t>(column.size()) * sizeof(T));
+        }
+
+        template<typename T>
+        void update_value(T const& value) noexcept {
+            static_assert(std::is_trivially_copyable_v<T>, "only trivially copyable values can be hashed by their bytes");
+            update(&value, sizeof(T));
+        }
+
+        auto digest() const noexcept -> std::uint64_t {
+            auto h = byte_count * prime1;
+            for(auto const lane : lanes) {
+                h = avalanche(h ^ avalanche(lane));
+            }
+            return h;
+        }
+
+    private:
+        static constexpr std::size_t lane_count = 4;
+        static constexpr std::uint64_t prime1 = 0x9E3779B185EBCA87ull;
+        static constexpr std::uint64_t prime2 = 0xC2B2AE3D27D4EB4Full;
+        static constexpr std::array<std::uint64_t, lane_count> keys = {
+            0xBE4BA423396CFEB8ull, 0x1CAD21F72C81017Cull, 0xDB979083E96DD4DEull, 0x1F67B3B7A4A44072ull,
+        };
+
+        static auto load(unsigned char const* bytes) noexcept -> std::uint64_t {
+            auto word = std::uint64_t(0);
+            std::memcpy(&word, bytes, sizeof(word));
+            return word;
+        }
+
+        static constexpr auto stripe_key(std::size_t lane, std::uint64_t stripe) noexcept -> std::uint64_t {
+            return keys[lane] + stripe * prime1;
+        }
+
+        static auto mix(std::uint64_t lane, std::uint64_t word, std::uint64_t key) noexcept -> std::uint64_t {
+            auto const keyed = word ^ key;
+            return lane + (keyed & 0xFFFFFFFFu) * (keyed >> 32) + word;
+        }
+
+        static constexpr auto avalanche(std::uint64_t h) noexcept -> std::uint64_t {
+            h ^= h >> 33;
+            h *= prime2;
+            h ^= h >> 29;
+            h *= prime1;
+            h ^= h >> 32;
+            return h;
+        }
+
+        void mix_word(std::uint64_t word) noexcept {
+            auto const lane = word_count % lane_count;
+            lanes[lane] = mix(lanes[lane], word, stripe_key(lane, word_count / lane_count));
+            ++word_count;
+        }
+
+        // Only called on a stripe boundary
+        void mix_stripes(unsigned char const* bytes, std::size_t stripes) noexcept {
+            auto const first_stripe = word_count / lane_count;
+            auto const first_keys = std::array<std::uint64_t, lane_count>{
+                stripe_key(0, first_stripe), stripe_key(1, first_stripe), stripe_key(2, first_stripe), stripe_key(3, first_stripe),
+            };
+#if defined(__AVX2__)
+            auto acc = _mm256_loadu_si256(reinterpret_cast<__m256i const*>(lanes.data()));
+            auto key = _mm256_loadu_si256(reinterpret_cast<__m256i const*>(first_keys.data()));
+            auto const key_step = _mm256_set1_epi64x(static_cast<long long>(prime1));
+            for(std::size_t s = 0; s < stripes; ++s) {
+                auto const word = _mm256_loadu_si256(reinterpret_cast<__m256i const*>(bytes + s * lane_count * sizeof(std::uint64_t)));
+                auto const keyed = _mm256_xor_si256(word, key);
+                auto const product = _mm256_mul_epu32(keyed, _mm256_srli_epi64(keyed, 32));
+                acc = _mm256_add_epi64(acc, _mm256_add_epi64(product, word));
+                key = _mm256_add_epi64(key, key_step);
+            }
+            _mm256_storeu_si256(reinterpret_cast<__m256i*>(lanes.data()), acc);
+#elif defined(HZ_HASH_SSE2)
+            auto acc_low = _mm_loadu_si128(reinterpret_cast<__m128i const*>(lanes.data()));
+            auto acc_high = _mm_loadu_si128(reinterpret_cast<__m128i const*>(lanes.data() + 2));
+            auto key_low = _mm_loadu_si128(reinterpret_cast<__m128i const*>(first_keys.data()));
+            auto key_high = _mm_loadu_si128(reinterpret_cast<__m128i const*>(first_keys.data() + 2));
+            auto const key_step = _mm_set1_epi64x(static_cast<long long>(prime1));
+            for(std::size_t s = 0; s < stripes; ++s) {
+                auto const* const stripe = bytes + s * lane_count * sizeof(std::uint64_t);
+                auto const word_low = _mm_loadu_si128(reinterpret_cast<__m128i const*>(stripe));
+                auto const word_high = _mm_loadu_si128(reinterpret_cast<__m128i const*>(stripe + 16));
+                auto const keyed_low = _mm_xor_si128(word_low, key_low);
+                auto const keyed_high = _mm_xor_si128(word_high, key_high);
+                acc_low = _mm_add_epi64(acc_low, _mm_add_epi64(_mm_mul_epu32(keyed_low, _mm_srli_epi64(keyed_low, 32)), word_low));
+                acc_high = _mm_add_epi64(acc_high, _mm_add_epi64(_mm_mul_epu32(keyed_high, _mm_srli_epi64(keyed_high, 32)), word_high));
+                key_low = _mm_add_epi64(key_low, key_step);
+                key_high = _mm_add_epi64(key_high, key_step);
+            }
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(lanes.data()), acc_low);
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(lanes.data() + 2), acc_high);
+#else
+            for(std::size_t s = 0; s < stripes; ++s) {
+                for(std::size_t lane = 0; lane < lane_count; ++lane) {
+                    lanes[lane] = mix(lanes[lane], load(bytes + (s * lane_count + lane) * sizeof(std::uint64_t)), first_keys[lane] + s * prime1);
+                }
+            }
+#endif
+            word_count += stripes * lane_count;
+        }
+
+        std::array<std::uint64_t, lane_count> lanes;
+        std::uint64_t word_count = 0;
+        std::uint64_t byte_count = 0;
+    };
+
+    // Checksums of the last ticks, to compare against another run or machine tick by tick
+    class checksum_stream {
+    public:
+        // Ticks are kept modulo the history, so it needs at least one entry
+        explicit checksum_stream(std::size_t history = 3600)
+            : checksums(history) {
+            Expects(history > 0);
+        }
+
+        void push(std::uint64_t tick, std::uint64_t checksum) noexcept {
+            checksums[tick % checksums.size()] = entry{tick, checksum, true};
+            latest = tick;
+        }
+
+        // Empty for ticks not pushed yet or already dropped from the history
+        auto get(std::uint64_t tick) const noexcept -> std::optional<std::uint64_t> {
+            auto const& e = checksums[tick % checksums.size()];
+            if(!e.valid || e.tick != tick) {
+                return std::nullopt;
+            }
+            return e.checksum;
+        }
+
+        auto get_latest_tick() const noexcept -> std::optional<std::uint64_t> {
+            return latest;
+        }
+
+    private:
+        struct entry {
+            std::uint64_t tick = 0;
+            std::uint64_t checksum = 0;
+            bool valid = false;
+        };
+
+        std::vector<entry> checksums;
+        std::optional<std::uint64_t> latest;
+    };
+}
@@ -0,0 +1,191 @@
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <ios>
+#include <iomanip>
+#include <memory>
+#include <mutex>
+#include <ostream>
+#include <thread>
+#include <utility>
+#include <vector>
+
+namespace hz::profile {
+    inline auto now_ns() noexcept -> std::int64_t {
+        return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch()).count();
+    }
+
+    struct zone_record {
+        char const* name;
+        std::int64_t begin_ns;
+        std::int64_t end_ns;
+    };
+
+    // Zones of one thread. Only its thread writes, and once full the oldest zones are overwritten
+    class thread_buffer {
+    public:
+        thread_buffer(std::uint32_t thread_id, std::size_t capacity)
+            : thread_id(thread_id)
+            , owner(std::this_thread::get_id())
+            , records(capacity) {
+
+        }
+
+        void push(zone_record record) noexcept {
+            auto const count = pushed.load(std::memory_order_relaxed);
+            records[count % records.size()] = record;
+            pushed.store(count + 1, std::memory_order_release);
+        }
+
+        // Oldest first
+        template<typename F>
+        void for_each(F && f) const {
+            auto const count = pushed.load(std::memory_order_acquire);
+            auto const kept = std::min<std::uint64_t>(count, records.size());
+            for(auto i = count - kept; i < count; ++i) {
+                f(records[i % records.size()]);
+            }
+        }
+
+        void clear() noexcept {
+            pushed.store(0, std::memory_order_release);
+        }
+
+        auto get_thread_id() const noexcept -> std::uint32_t {
+            return thread_id;
+        }
+
+        auto get_owner() const noexcept -> std::thread::id {
+            return owner;
+        }
+
+    private:
+        std::uint32_t thread_id;
+        std::thread::id owner;
+        std::vector<zone_record> records;
+        std::atomic<std::uint64_t> pushed = 0;
+    };
+
+    // Owns one ring buffer per thread that ever recorded a zone, so recording takes no lock once a thread has its buffer.
+    // Dumping reads the buffers while other threads may still write, so zones recorded during the dump may come out
+    // torn; dump between frames, when the job pool is idle
+    class profiler {
+    public:
+        explicit profiler(std::size_t zones_per_thread = 1 << 16)
+            : id(next_id()++)
+            , zones_per_thread(zones_per_thread)
+            , epoch_ns(now_ns()) {
+
+        }
+
+        static auto get() -> profiler & {
+            static auto instance = profiler();
+            return instance;
+        }
+
+        // Cached per thread for the last profiler it recorded to
+        auto get_thread_buffer() -> thread_buffer & {
+            thread_local auto cache = std::pair<std::uint64_t, thread_buffer*>(0, nullptr);
+            if(cache.first != id) {
+                auto const lock = std::lock_guard(buffers_mutex);
+                auto const thread = std::this_thread::get_id();
+                auto const it = std::find_if(buffers.begin(), buffers.end(), [thread] (auto const& b) { return b->get_owner() == thread; });
+                if(it != buffers.end()) {
+                    cache = {id, it->get()};
+                } else {
+                    buffers.push_back(std::make_unique<thread_buffer>(static_cast<std::uint32_t>(buffers.size()), zones_per_thread));
+                    cache = {id, buffers.back().get()};
+                }
+            }
+            return *cache.second;
+        }
+
+        // Like dumping, only safe while no other thread records zones
+        void clear() {
+            auto const lock = std::lock_guard(buffers_mutex);
+            for(auto const& buffer : buffers) {
+                buffer->clear();
+            }
+        }
+
+        // Chrome trace event format, as loaded by chrome://tracing and Perfetto: one complete event per zone, with
+        // microsecond timestamps from the profiler's creation
+        void write_chrome_trace(std::ostream & out) const {
+            auto const lock = std::lock_guard(buffers_mutex);
+            auto const flags = out.flags();
+            auto const precision = out.precision();
+            out << std::fixed << std::setprecision(3) << "{\"traceEvents\":[";
+            auto first = true;
+            for(auto const& buffer : buffers) {
+                buffer->for_each([&] (zone_record const& zone) {
+                    out << (first ? "\n" : ",\n") << "{\"name\":\"";
+                    write_escaped(out, zone.name);
+                    out << "\",\"ph\":\"X\",\"pid\":0,\"tid\":" << buffer->get_thread_id()
+                        << ",\"ts\":" << static_cast<double>(zone.begin_ns - epoch_ns) / 1000.0
+                        << ",\"dur\":" << static_cast<double>(zone.end_ns - zone.begin_ns) / 1000.0 << "}";
+                    first = false;
+                });
+            }
+            out << "\n],\"displayTimeUnit\":\"ms\"}\n";
+            out.flags(flags);
+            out.precision(precision);
+        }
+
+    private:
+        // Starts at 1, since 0 marks an empty thread cache
+        static auto next_id() -> std::atomic<std::uint64_t> & {
+            static auto counter = std::atomic<std::uint64_t>(1);
+            return counter;
+        }
+
+        static void write_escaped(std::ostream & out, char const* text) {
+            for(; *text != '\0'; ++text) {
+                if(*text == '"' || *text == '\\') {
+                    out << '\\';
+                }
+                out << *text;
+            }
+        }
+
+        std::uint64_t id;
+        std::size_t zones_per_thread;
+        std::int64_t epoch_ns;
+        mutable std::mutex buffers_mutex;
+        std::vector<std::unique_ptr<thread_buffer>> buffers;
+    };
+
+    // Records the time between its construction and destruction as a zone. Names must outlive the profiler, as
+    // string literals do
+    class scoped_zone {
+    public:
+        explicit scoped_zone(char const* name, profiler & p = profiler::get()) noexcept
+            : name(name)
+            , owner(p)
+            , begin_ns(now_ns()) {
+
+        }
+        scoped_zone(scoped_zone const&) = delete;
+        auto operator=(scoped_zone const&) -> scoped_zone & = delete;
+        ~scoped_zone() {
+            owner.get_thread_buffer().push({name, begin_ns, now_ns()});
+        }
+
+    private:
+        char const* name;
+        profiler & owner;
+        std::int64_t begin_ns;
+    };
+}
+
+// Zones are only recorded in builds with AGEA_PROFILE defined, and compile to nothing otherwise
+#define HZ_PROFILE_CONCAT_IMPL(a, b) a##b
+#define HZ_PROFILE_CONCAT(a, b) HZ_PROFILE_CONCAT_IMPL(a, b)
+#if defined(AGEA_PROFILE)
+#define HZ_PROFILE_ZONE(name) ::hz::profile::scoped_zone const HZ_PROFILE_CONCAT(hz_profile_zone_, __LINE__)(name)
+#else
+#define HZ_PROFILE_ZONE(name) static_cast<void>(0)
+#endif
@@ -0,0 +1,159 @@
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+namespace hz::thread {
+    // Work-stealing pool for fork-join loops. Each worker owns a queue of range jobs, pops from its back and steals from
+    // the front of the others' queues when empty. The thread calling parallel_for takes part in the work as well.
+    // A pool without workers runs everything on the calling thread
+    class job_pool {
+    public:
+        explicit job_pool(std::size_t worker_count)
+            : queues(worker_count + 1) {
+            for(auto & queue : queues) {
+                queue = std::make_unique<job_queue>();
+            }
+            workers.reserve(worker_count);
+            for(std::size_t i = 0; i < worker_count; ++i) {
+                workers.emplace_back([this, i] { worker_loop(i + 1); });
+            }
+        }
+        job_pool(job_pool const&) = delete;
+        auto operator=(job_pool const&) -> job_pool & = delete;
+        ~job_pool() {
+            {
+                auto const lock = std::lock_guard(sleep_mutex);
+                stopping = true;
+            }
+            sleep_condition.notify_all();
+            for(auto & worker : workers) {
+                worker.join();
+            }
+        }
+
+        auto get_worker_count() const noexcept -> std::size_t {
+            return workers.size();
+        }
+
+        // Calls f(chunk_begin, chunk_end) over [begin, end) split into chunks of chunk_size, and returns once every chunk is done.
+        // Chunks may run concurrently, so f must only touch data owned by its chunk
+        template<typename F>
+        void parallel_for(std::ptrdiff_t begin, std::ptrdiff_t end, std::ptrdiff_t chunk_size, F && f) {
+            chunk_size = std::max<std::ptrdiff_t>(chunk_size, 1);
+            if(workers.empty() || end - begin <= chunk_size) {
+                if(begin < end) {
+                    f(begin, end);
+                }
+                return;
+            }
+
+            auto const invoke = [] (void * context, std::ptrdiff_t b, std::ptrdiff_t e) {
+                (*static_cast<std::remove_reference_t<F>*>(context))(b, e);
+            };
+            auto remaining = std::atomic<std::ptrdiff_t>((end - begin + chunk_size - 1) / chunk_size);
+
+            auto queue_index = std::size_t(0);
+            for(auto b = begin; b < end; b += chunk_size) {
+                push(queue_index, job{invoke, &f, b, std::min(b + chunk_size, end), &remaining});
+                queue_index = (queue_index + 1) % queues.size();
+            }
+            {
+                // Workers check the queued count under this mutex, so taking it orders the pushes before their next check
+                auto const lock = std::lock_guard(sleep_mutex);
+            }
+            sleep_condition.notify_all();
+
+            while(remaining.load(std::memory_order_acquire) > 0) {
+                if(auto const j = find_job(0)) {
+                    run(*j);
+                } else {
+                    std::this_thread::yield();
+                }
+            }
+        }
+
+    private:
+        struct job {
+            void (*invoke)(void *, std::ptrdiff_t, std::ptrdiff_t);
+            void * context;
+            std::ptrdiff_t begin;
+            std::ptrdiff_t end;
+            std::atomic<std::ptrdiff_t> * remaining;
+        };
+
+        struct job_queue {
+            std::mutex mutex;
+            std::deque<job> jobs;
+        };
+
+        void push(std::size_t queue_index, job j) {
+            {
+                auto & queue = *queues[queue_index];
+                auto const lock = std::lock_guard(queue.mutex);
+                queue.jobs.push_back(j);
+            }
+            queued.fetch_add(1, std::memory_order_release);
+        }
+
+        auto find_job(std::size_t self) -> std::optional<job> {
+            {
+                auto & own = *queues[self];
+                auto const lock = std::lock_guard(own.mutex);
+                if(!own.jobs.empty()) {
+                    auto const j = own.jobs.back();
+                    own.jobs.pop_back();
+                    queued.fetch_sub(1, std::memory_order_relaxed);
+                    return j;
+                }
+            }
+            for(std::size_t offset = 1; offset < queues.size(); ++offset) {
+                auto & victim = *queues[(self + offset) % queues.size()];
+                auto const lock = std::lock_guard(victim.mutex);
+                if(!victim.jobs.empty()) {
+                    auto const j = victim.jobs.front();
+                    victim.jobs.pop_front();
+                    queued.fetch_sub(1, std::memory_order_relaxed);
+                    return j;
+                }
+            }
+            return std::nullopt;
+        }
+
+        static void run(job const& j) {
+            j.invoke(j.context, j.begin, j.end);
+            j.remaining->fetch_sub(1, std::memory_order_release);
+        }
+
+        void worker_loop(std::size_t self) {
+            while(true) {
+                if(auto const j = find_job(self)) {
+                    run(*j);
+                    continue;
+                }
+
+                auto lock = std::unique_lock(sleep_mutex);
+                sleep_condition.wait(lock, [this] { return stopping || queued.load(std::memory_order_acquire) > 0; });
+                if(stopping) {
+                    return;
+                }
+            }
+        }
+
+        std::vector<std::unique_ptr<job_queue>> queues;
+        std::vector<std::thread> workers;
+        std::atomic<std::ptrdiff_t> queued = 0;
+        std::mutex sleep_mutex;
+        std::condition_variable sleep_condition;
+        bool stopping = false;
+    };
+}
@@ -0,0 +1,52 @@
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <cstdint>
+
+namespace hz::thread {
+    // Lock-free single-producer single-consumer triple buffer. The writer fills its back buffer and publishes it, the reader
+    // always gets the latest published buffer. Neither side ever waits, and a buffer is never handed to both at once
+    template<typename T>
+    class triple_buffer {
+    public:
+        triple_buffer() = default;
+        triple_buffer(triple_buffer const&) = delete;
+        auto operator=(triple_buffer const&) -> triple_buffer & = delete;
+
+        // Writer side: buffer to fill for the next publish. It holds the contents of some earlier publish, either one the
+        // reader skipped or the one it last read, or a default T, so fill all of it
+        auto get_write_buffer() noexcept -> T & {
+            return buffers[back].value;
+        }
+
+        void publish() noexcept {
+            back = middle.exchange(back | fresh_bit, std::memory_order_acq_rel) & index_mask;
+        }
+
+        // Reader side: latest published buffer, or the one previously read if nothing was published since
+        auto read() noexcept -> T const& {
+            if(has_update()) {
+                front = middle.exchange(front, std::memory_order_acq_rel) & index_mask;
+            }
+            return buffers[front].value;
+        }
+
+        auto has_update() const noexcept -> bool {
+            return (middle.load(std::memory_order_relaxed) & fresh_bit) != 0;
+        }
+
+    private:
+        static constexpr std::uint8_t index_mask = 0x3;
+        static constexpr std::uint8_t fresh_bit = 0x4;
+
+        struct alignas(64) slot {
+            T value = {};
+        };
+
+        std::array<slot, 3> buffers;
+        alignas(64) std::uint8_t back = 0;
+        alignas(64) std::atomic<std::uint8_t> middle = 1;
+        alignas(64) std::uint8_t front = 2;
+    };
+}
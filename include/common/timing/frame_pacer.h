@@ -0,0 +1,102 @@
+#pragma once
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <thread>
+
+namespace hz::timing {
+    using clock = std::chrono::steady_clock;
+
+    // How late frames were released past their deadlines
+    class jitter_stats {
+    public:
+        void add(clock::duration lateness) noexcept {
+            auto const us = std::chrono::duration<double, std::micro>(lateness).count();
+            ++count;
+            sum += us;
+            sum_squares += us * us;
+            max = std::max(max, us);
+        }
+
+        auto get_count() const noexcept -> std::uint64_t {
+            return count;
+        }
+        auto get_mean_us() const noexcept -> double {
+            return count > 0 ? sum / static_cast<double>(count) : 0.0;
+        }
+        auto get_stddev_us() const noexcept -> double {
+            if(count == 0) {
+                return 0.0;
+            }
+            auto const mean = get_mean_us();
+            return std::sqrt(std::max(0.0, sum_squares / static_cast<double>(count) - mean * mean));
+        }
+        auto get_max_us() const noexcept -> double {
+            return max;
+        }
+
+    private:
+        std::uint64_t count = 0;
+        double sum = 0.0;
+        double sum_squares = 0.0;
+        double max = 0.0;
+    };
+
+    // Releases one frame per period on a fixed deadline grid. Waits sleep until spin_window before the deadline, since
+    // the OS may oversleep by a millisecond or more, then yield in a loop until the deadline itself. A frame that
+    // overran its period restarts the grid from now instead of releasing a burst of frames to catch up
+    class frame_pacer {
+    public:
+        explicit frame_pacer(clock::duration period, clock::duration spin_window = std::chrono::milliseconds(2))
+            : period(period)
+            , spin_window(spin_window)
+            , deadline(clock::now() + period) {
+
+        }
+
+        // Returns once the current frame's deadline has passed
+        void wait() {
+            auto now = clock::now();
+            if(now < deadline - spin_window) {
+                std::this_thread::sleep_until(deadline - spin_window);
+                now = clock::now();
+            }
+            while(now < deadline) {
+                std::this_thread::yield();
+                now = clock::now();
+            }
+
+            stats.add(now - deadline);
+            deadline += period;
+            if(deadline <= now) {
+                ++overruns;
+                deadline = now + period;
+            }
+        }
+
+        // Restarts the grid from now, after a pause that should not count as an overrun
+        void reset() {
+            deadline = clock::now() + period;
+        }
+
+        auto get_period() const noexcept -> clock::duration {
+            return period;
+        }
+        auto get_stats() const noexcept -> jitter_stats const& {
+            return stats;
+        }
+        // Frames whose work took longer than the period
+        auto get_overruns() const noexcept -> std::uint64_t {
+            return overruns;
+        }
+
+    private:
+        clock::duration period;
+        clock::duration spin_window;
+        clock::time_point deadline;
+        jitter_stats stats;
+        std::uint64_t overruns = 0;
+    };
+}
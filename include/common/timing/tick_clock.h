@@ -0,0 +1,78 @@
+#pragma once
+
+#include <chrono>
+#include <cstdint>
+
+namespace hz::timing {
+    // Counts the fixed step ticks due as wall time passes. Time is kept in integer nanoseconds scaled by the tick rate,
+    // in which one tick is exactly a second's worth of nanoseconds whatever the rate, so no rounding builds up: after
+    // any run, ticks taken plus ticks dropped plus ticks still due is exactly the elapsed time times the rate
+    class tick_clock {
+    public:
+        explicit tick_clock(std::uint32_t rate) noexcept
+            : rate(rate) {
+
+        }
+
+        // Measure elapsed time as differences of integer clock readings, which add up to the exact total
+        void advance(std::chrono::nanoseconds elapsed) noexcept {
+            backlog += elapsed.count() * static_cast<std::int64_t>(rate);
+        }
+
+        auto is_tick_due() const noexcept -> bool {
+            return backlog >= units_per_tick;
+        }
+
+        // Returns the index of the tick taken. Only call while a tick is due
+        auto take_tick() noexcept -> std::uint64_t {
+            backlog -= units_per_tick;
+            return tick++;
+        }
+
+        // Drops the due ticks beyond max_ticks, so that a loop which fell behind does not fall further behind catching up
+        void limit_backlog(std::uint64_t max_ticks) noexcept {
+            auto const max_backlog = static_cast<std::int64_t>(max_ticks) * units_per_tick + units_per_tick - 1;
+            if(backlog > max_backlog) {
+                auto const excess = (backlog - max_backlog + units_per_tick - 1) / units_per_tick;
+                backlog -= excess * units_per_tick;
+                dropped += static_cast<std::uint64_t>(excess);
+            }
+        }
+
+        // How far wall time is into the next tick, from 0 to 1, to blend rendered positions between ticks
+        auto get_alpha() const noexcept -> double {
+            return static_cast<double>(backlog) / static_cast<double>(units_per_tick);
+        }
+
+        // Index of the next tick to take, which is also how many were taken
+        auto get_tick() const noexcept -> std::uint64_t {
+            return tick;
+        }
+
+        auto get_dropped_ticks() const noexcept -> std::uint64_t {
+            return dropped;
+        }
+
+        auto get_rate() const noexcept -> std::uint32_t {
+            return rate;
+        }
+
+        // The simulated time step of one tick
+        auto get_tick_duration() const noexcept -> std::chrono::duration<double> {
+            return std::chrono::duration<double>(1.0 / rate);
+        }
+
+        // One tick rounded to whole nanoseconds, for pacing frames
+        auto get_period() const noexcept -> std::chrono::nanoseconds {
+            return std::chrono::nanoseconds((units_per_tick + rate / 2) / rate);
+        }
+
+    private:
+        static constexpr std::int64_t units_per_tick = 1'000'000'000;
+
+        std::uint32_t rate;
+        std::int64_t backlog = 0;
+        std::uint64_t tick = 0;
+        std::uint64_t dropped = 0;
+    };
+}
@@ -1,6 +1,8 @@
 #pragma once
 
+#include <algorithm>
 #include <variant>
+#include <vector>
 #include <string_view>
 #include <string>
 
@@ -64,7 +66,57 @@ namespace hz::input {
             return *this;
         }
 
+        auto begin() const noexcept {
+            return events.begin();
+        }
+        auto end() const noexcept {
+            return events.end();
+        }
+        auto size() const noexcept -> std::size_t {
+            return events.size();
+        }
+
     private:
         std::vector<event_t> events;
     };
+
+    // Which direction keys are down, following their pressed and released events
+    class held_keys {
+    public:
+        void update(event_state_t const& state) noexcept {
+            auto const check = [&state] (event_label pressed, event_label released, bool & held) {
+                if(state.has(pressed)) {
+                    held = true;
+                } else if(state.has(released)) {
+                    held = false;
+                }
+            };
+            check(event_label::up_pressed, event_label::up_released, up);
+            check(event_label::down_pressed, event_label::down_released, down);
+            check(event_label::left_pressed, event_label::left_released, left);
+            check(event_label::right_pressed, event_label::right_released, right);
+        }
+
+        auto is_up_held() const noexcept -> bool {
+            return up;
+        }
+        auto is_down_held() const noexcept -> bool {
+            return down;
+        }
+        auto is_left_held() const noexcept -> bool {
+            return left;
+        }
+        auto is_right_held() const noexcept -> bool {
+            return right;
+        }
+        auto is_any_held() const noexcept -> bool {
+            return up || down || left || right;
+        }
+
+    private:
+        bool up = false;
+        bool down = false;
+        bool left = false;
+        bool right = false;
+    };
 }
@@ -0,0 +1,203 @@
+#pragma once
+
+#include <array>
+#include <cstdint>
+#include <istream>
+#include <optional>
+#include <ostream>
+#include <string>
+#include <variant>
+
+#include "input/event.h"
+
+namespace hz::input {
+    // Binary log of the event state handed to each tick, to replay a session tick for tick without a window.
+    // The header holds a magic, the version, and the scene size and tick rate the session ran with, since a replay only
+    // reproduces it with the same ones. Each tick is an event count followed by the events, a kind byte then either the
+    // label byte or a length prefixed string, and ends with the checksum of the state the tick produced, so that a
+    // replay can tell the first tick that diverged. Integers are little endian whatever the platform
+    namespace recording {
+        inline constexpr std::array<char, 4> magic = {'H', 'Z', 'I', 'R'};
+        inline constexpr std::uint32_t version = 2;
+
+        struct header {
+            std::uint64_t box_count = 0;
+            std::uint32_t tick_rate = 0;
+        };
+
+        struct recorded_tick {
+            event_state_t events;
+            std::uint64_t checksum;
+        };
+
+        enum class event_kind : std::uint8_t {
+            label,
+            text,
+        };
+
+        namespace detail {
+            inline void write_u32(std::ostream & out, std::uint32_t value) {
+                auto const bytes = std::array<char, 4>{
+                    static_cast<char>(value & 0xFF), static_cast<char>((value >> 8) & 0xFF),
+                    static_cast<char>((value >> 16) & 0xFF), static_cast<char>((value >> 24) & 0xFF),
+                };
+                out.write(bytes.data(), bytes.size());
+            }
+
+            inline void write_u64(std::ostream & out, std::uint64_t value) {
+                write_u32(out, static_cast<std::uint32_t>(value));
+                write_u32(out, static_cast<std::uint32_t>(value >> 32));
+            }
+
+            inline auto read_u32(std::istream & in) -> std::optional<std::uint32_t> {
+                auto bytes = std::array<unsigned char, 4>();
+                if(!in.read(reinterpret_cast<char*>(bytes.data()), bytes.size())) {
+                    return std::nullopt;
+                }
+                return std::uint32_t(bytes[0]) | std::uint32_t(bytes[1]) << 8 | std::uint32_t(bytes[2]) << 16 | std::uint32_t(bytes[3]) << 24;
+            }
+
+            inline auto read_u64(std::istream & in) -> std::optional<std::uint64_t> {
+                auto const low = read_u32(in);
+                auto const high = low ? read_u32(in) : std::nullopt;
+                if(!high) {
+                    return std::nullopt;
+                }
+                return std::uint64_t(*low) | std::uint64_t(*high) << 32;
+            }
+
+            inline auto read_u8(std::istream & in) -> std::optional<std::uint8_t> {
+                auto const c = in.get();
+                if(c == std::istream::traits_type::eof()) {
+                    return std::nullopt;
+                }
+                return static_cast<std::uint8_t>(c);
+            }
+        }
+    }
+
+    class event_recorder {
+    public:
+        // The stream should be opened in binary mode
+        event_recorder(std::ostream & out, recording::header const& h)
+            : out(out) {
+            out.write(recording::magic.data(), recording::magic.size());
+            recording::detail::write_u32(out, recording::version);
+            recording::detail::write_u64(out, h.box_count);
+            recording::detail::write_u32(out, h.tick_rate);
+        }
+
+        // Call once the tick has run, with the input it took and the checksum of the state it produced
+        void record(event_state_t const& state, std::uint64_t checksum) {
+            recording::detail::write_u32(out, static_cast<std::uint32_t>(state.size()));
+            for(auto const& e : state) {
+                if(auto const label = std::get_if<event_label>(&e.get_value())) {
+                    out.put(static_cast<char>(recording::event_kind::label));
+                    out.put(static_cast<char>(*label));
+                } else {
+                    auto const& text = std::get<std::string>(e.get_value());
+                    out.put(static_cast<char>(recording::event_kind::text));
+                    recording::detail::write_u32(out, static_cast<std::uint32_t>(text.size()));
+                    out.write(text.data(), static_cast<std::streamsize>(text.size()));
+                }
+            }
+            recording::detail::write_u64(out, checksum);
+        }
+
+        auto good() const -> bool {
+            return out.good();
+        }
+
+    private:
+        std::ostream & out;
+    };
+
+    class event_player {
+    public:
+        // Check good() before reading: it is false for streams that are not recordings of this version
+        explicit event_player(std::istream & in)
+            : in(in) {
+            auto magic = std::array<char, 4>();
+            valid = in.read(magic.data(), magic.size()) && magic == recording::magic
+                && recording::detail::read_u32(in) == recording::version;
+            if(valid) {
+                auto const box_count = recording::detail::read_u64(in);
+                auto const tick_rate = box_count ? recording::detail::read_u32(in) : std::nullopt;
+                valid = tick_rate.has_value() && *tick_rate > 0;
+                if(valid) {
+                    h = recording::header{*box_count, *tick_rate};
+                }
+            }
+        }
+
+        // The scene and rate to replay with
+        auto get_header() const noexcept -> recording::header const& {
+            return h;
+        }
+
+        // The next tick, or nothing at the end of the recording or on a truncated or corrupt tick
+        auto next() -> std::optional<recording::recorded_tick> {
+            if(!valid) {
+                return std::nullopt;
+            }
+            auto const count = recording::detail::read_u32(in);
+            if(!count) {
+                valid = false;
+                return std::nullopt;
+            }
+
+            auto state = event_state_t();
+            for(std::uint32_t i = 0; i < *count; ++i) {
+                auto e = read_event();
+                if(!e) {
+                    valid = false;
+                    return std::nullopt;
+                }
+                state.push(std::move(*e));
+            }
+            auto const checksum = recording::detail::read_u64(in);
+            if(!checksum) {
+                valid = false;
+                return std::nullopt;
+            }
+            return recording::recorded_tick{std::move(state), *checksum};
+        }
+
+        auto good() const noexcept -> bool {
+            return valid;
+        }
+
+    private:
+        auto read_event() -> std::optional<event_t> {
+            auto const kind = recording::detail::read_u8(in);
+            if(!kind) {
+                return std::nullopt;
+            }
+            switch(static_cast<recording::event_kind>(*kind)) {
+                case recording::event_kind::label: {
+                    auto const label = recording::detail::read_u8(in);
+                    if(!label || *label > static_cast<std::uint8_t>(event_label::right_released)) {
+                        return std::nullopt;
+                    }
+                    return event_t(static_cast<event_label>(*label));
+                }
+                case recording::event_kind::text: {
+                    auto const length = recording::detail::read_u32(in);
+                    if(!length) {
+                        return std::nullopt;
+                    }
+                    auto text = std::string(*length, '\0');
+                    if(!in.read(text.data(), static_cast<std::streamsize>(text.size()))) {
+                        return std::nullopt;
+                    }
+                    return event_t(text);
+                }
+            }
+            return std::nullopt;
+        }
+
+        std::istream & in;
+        recording::header h;
+        bool valid = false;
+    };
+}
@@ -0,0 +1,196 @@
+#pragma once
+
+#include <cstdint>
+
+namespace hz::math {
+    namespace detail {
+        // Bits [shift, shift + 64) of the two's complement 128 bit product a * b, i.e. (a * b) >> shift rounded towards
+        // negative infinity. Portable fallback for compilers without a 128 bit integer
+        constexpr auto multiply_shift_portable(std::int64_t a, std::int64_t b, int shift) noexcept -> std::int64_t {
+            auto const ua = static_cast<std::uint64_t>(a);
+            auto const ub = static_cast<std::uint64_t>(b);
+            auto const a_lo = ua & 0xFFFFFFFFu;
+            auto const a_hi = ua >> 32;
+            auto const b_lo = ub & 0xFFFFFFFFu;
+            auto const b_hi = ub >> 32;
+
+            auto const lo_lo = a_lo * b_lo;
+            auto const hi_lo = a_hi * b_lo;
+            auto const lo_hi = a_lo * b_hi;
+            auto const middle = (lo_lo >> 32) + (hi_lo & 0xFFFFFFFFu) + (lo_hi & 0xFFFFFFFFu);
+            auto const lo = (middle << 32) | (lo_lo & 0xFFFFFFFFu);
+            // Unsigned high half, corrected into the signed one
+            auto hi = a_hi * b_hi + (hi_lo >> 32) + (lo_hi >> 32) + (middle >> 32);
+            if(a < 0) {
+                hi -= ub;
+            }
+            if(b < 0) {
+                hi -= ua;
+            }
+
+            if(shift == 0) {
+                return static_cast<std::int64_t>(lo);
+            }
+            return static_cast<std::int64_t>((hi << (64 - shift)) | (lo >> shift));
+        }
+
+        // (a << shift) / b, truncated towards zero
+        constexpr auto shift_divide_portable(std::int64_t a, std::int64_t b, int shift) noexcept -> std::int64_t {
+            auto const negative = (a < 0) != (b < 0);
+            auto const ua = a < 0 ? 0 - static_cast<std::uint64_t>(a) : static_cast<std::uint64_t>(a);
+            auto const ub = b < 0 ? 0 - static_cast<std::uint64_t>(b) : static_cast<std::uint64_t>(b);
+
+            // Long division of the 128 bit dividend ua << shift, one bit at a time
+            auto const dividend_hi = shift == 0 ? std::uint64_t(0) : ua >> (64 - shift);
+            auto const dividend_lo = ua << shift;
+            auto remainder = std::uint64_t(0);
+            auto quotient = std::uint64_t(0);
+            for(int bit = 127; bit >= 0; --bit) {
+                auto const carry = remainder >> 63;
+                auto const next = bit >= 64 ? (dividend_hi >> (bit - 64)) & 1 : (dividend_lo >> bit) & 1;
+                remainder = (remainder << 1) | next;
+                if(carry != 0 || remainder >= ub) {
+                    remainder -= ub;
+                    if(bit < 64) {
+                        quotient |= std::uint64_t(1) << bit;
+                    }
+                }
+            }
+            return negative ? static_cast<std::int64_t>(0 - quotient) : static_cast<std::int64_t>(quotient);
+        }
+
+        // Rounds half away from zero and saturates at the 64 bit limits, instead of the undefined behaviour of casting a
+        // double out of range. NaN gives zero
+        constexpr auto round_saturate(double value) noexcept -> std::int64_t {
+            // 2^63, exact in a double
+            constexpr auto limit = 9223372036854775808.0;
+            if(value != value) {
+                return 0;
+            }
+            if(value >= limit) {
+                return INT64_MAX;
+            }
+            if(value <= -limit) {
+                return INT64_MIN;
+            }
+            auto const truncated = static_cast<std::int64_t>(value);
+            // Exact, and only non-zero below 2^52 where adding one cannot overflow
+            auto const fraction = value - static_cast<double>(truncated);
+            if(fraction >= 0.5) {
+                return truncated + 1;
+            }
+            if(fraction <= -0.5) {
+                return truncated - 1;
+            }
+            return truncated;
+        }
+    }
+
+    // Fixed-point number with FractionBits fractional bits in a 64 bit integer. Integer arithmetic gives the same bits on
+    // every compiler, flag set and platform, which lockstep simulation needs. Multiplication rounds towards negative
+    // infinity and division towards zero; neither checks for overflow
+    template<int FractionBits>
+    class basic_fixed {
+        static_assert(FractionBits >= 0 && FractionBits < 63, "basic_fixed needs at least one integer bit besides the sign");
+
+    public:
+        static constexpr int fraction_bits = FractionBits;
+        static constexpr std::int64_t one = std::int64_t(1) << FractionBits;
+
+        basic_fixed() = default;
+        // Exact, hence implicit
+        constexpr basic_fixed(int value) noexcept
+            : raw(static_cast<std::int64_t>(value) * one) {
+
+        }
+        // Rounds to the nearest representable value, saturating beyond the range
+        constexpr explicit basic_fixed(double value) noexcept
+            : raw(detail::round_saturate(value * static_cast<double>(one))) {
+
+        }
+
+        static constexpr auto from_raw(std::int64_t raw) noexcept -> basic_fixed {
+            auto f = basic_fixed();
+            f.raw = raw;
+            return f;
+        }
+
+        constexpr auto get_raw() const noexcept -> std::int64_t {
+            return raw;
+        }
+        constexpr auto to_double() const noexcept -> double {
+            return static_cast<double>(raw) / static_cast<double>(one);
+        }
+        constexpr explicit operator double() const noexcept {
+            return to_double();
+        }
+
+        constexpr auto operator+() const noexcept -> basic_fixed {
+            return *this;
+        }
+        constexpr auto operator-() const noexcept -> basic_fixed {
+            return from_raw(-raw);
+        }
+
+        constexpr auto operator+=(basic_fixed other) noexcept -> basic_fixed & {
+            raw += other.raw;
+            return *this;
+        }
+        constexpr auto operator-=(basic_fixed other) noexcept -> basic_fixed & {
+            raw -= other.raw;
+            return *this;
+        }
+        constexpr auto operator*=(basic_fixed other) noexcept -> basic_fixed & {
+            return *this = *this * other;
+        }
+        constexpr auto operator/=(basic_fixed other) noexcept -> basic_fixed & {
+            return *this = *this / other;
+        }
+
+        friend constexpr auto operator+(basic_fixed lhs, basic_fixed rhs) noexcept -> basic_fixed {
+            return from_raw(lhs.raw + rhs.raw);
+        }
+        friend constexpr auto operator-(basic_fixed lhs, basic_fixed rhs) noexcept -> basic_fixed {
+            return from_raw(lhs.raw - rhs.raw);
+        }
+        friend constexpr auto operator*(basic_fixed lhs, basic_fixed rhs) noexcept -> basic_fixed {
+#if defined(__SIZEOF_INT128__)
+            return from_raw(static_cast<std::int64_t>((static_cast<__int128>(lhs.raw) * rhs.raw) >> FractionBits));
+#else
+            return from_raw(detail::multiply_shift_portable(lhs.raw, rhs.raw, FractionBits));
+#endif
+        }
+        friend constexpr auto operator/(basic_fixed lhs, basic_fixed rhs) noexcept -> basic_fixed {
+#if defined(__SIZEOF_INT128__)
+            return from_raw(static_cast<std::int64_t>(static_cast<__int128>(lhs.raw) * one / rhs.raw));
+#else
+            return from_raw(detail::shift_divide_portable(lhs.raw, rhs.raw, FractionBits));
+#endif
+        }
+
+        friend constexpr auto operator==(basic_fixed lhs, basic_fixed rhs) noexcept -> bool {
+            return lhs.raw == rhs.raw;
+        }
+        friend constexpr auto operator!=(basic_fixed lhs, basic_fixed rhs) noexcept -> bool {
+            return lhs.raw != rhs.raw;
+        }
+        friend constexpr auto operator<(basic_fixed lhs, basic_fixed rhs) noexcept -> bool {
+            return lhs.raw < rhs.raw;
+        }
+        friend constexpr auto operator<=(basic_fixed lhs, basic_fixed rhs) noexcept -> bool {
+            return lhs.raw <= rhs.raw;
+        }
+        friend constexpr auto operator>(basic_fixed lhs, basic_fixed rhs) noexcept -> bool {
+            return lhs.raw > rhs.raw;
+        }
+        friend constexpr auto operator>=(basic_fixed lhs, basic_fixed rhs) noexcept -> bool {
+            return lhs.raw >= rhs.raw;
+        }
+
+    private:
+        std::int64_t raw = 0;
+    };
+
+    // 32.32: about 2e9 units of range at 2.3e-10 resolution
+    using fixed = basic_fixed<32>;
+}
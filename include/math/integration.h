@@ -1,8 +1,179 @@
 #pragma once
 
+#include <algorithm>
+#include <cmath>
+#include <utility>
+
 namespace hz::math {
     template<typename Y, typename F, typename T, typename H>
     constexpr auto rk1(Y y1, F f, T t1, H h) noexcept {
         return y1 + f(t1, y1)*h;
     }
-}
\ No newline at end of file
+
+    // Integrator policies for second order systems x'' = a(t, x, v). Each step(x, v, a, t, h) advances position x and
+    // velocity v by h and returns both. Quantities only need + between themselves and * by a scalar
+
+    // Explicit Euler, first order. Both updates use the state at the start of the step
+    struct euler {
+        template<typename X, typename V, typename A, typename T, typename H>
+        static constexpr auto step(X x, V v, A && a, T t, H h) -> std::pair<X, V> {
+            return {x + v*h, v + a(t, x, v)*h};
+        }
+    };
+
+    // Velocity Verlet, second order and symplectic for forces that do not depend on velocity. Velocity-dependent forces
+    // are evaluated with the half step velocity
+    struct velocity_verlet {
+        template<typename X, typename V, typename A, typename T, typename H>
+        static constexpr auto step(X x, V v, A && a, T t, H h) -> std::pair<X, V> {
+            auto const half_v = v + a(t, x, v)*(h/2);
+            auto const next_x = x + half_v*h;
+            return {next_x, half_v + a(t + h, next_x, half_v)*(h/2)};
+        }
+    };
+
+    // Midpoint Runge-Kutta, second order
+    struct rk2 {
+        template<typename X, typename V, typename A, typename T, typename H>
+        static constexpr auto step(X x, V v, A && a, T t, H h) -> std::pair<X, V> {
+            auto const mid_x = x + v*(h/2);
+            auto const mid_v = v + a(t, x, v)*(h/2);
+            return {x + mid_v*h, v + a(t + h/2, mid_x, mid_v)*h};
+        }
+    };
+
+    // Classic Runge-Kutta, fourth order
+    struct rk4 {
+        template<typename X, typename V, typename A, typename T, typename H>
+        static constexpr auto step(X x, V v, A && a, T t, H h) -> std::pair<X, V> {
+            auto const k1_x = v;
+            auto const k1_v = a(t, x, v);
+            auto const k2_x = v + k1_v*(h/2);
+            auto const k2_v = a(t + h/2, x + k1_x*(h/2), k2_x);
+            auto const k3_x = v + k2_v*(h/2);
+            auto const k3_v = a(t + h/2, x + k2_x*(h/2), k3_x);
+            auto const k4_x = v + k3_v*h;
+            auto const k4_v = a(t + h, x + k3_x*h, k4_x);
+            return {x + (k1_x + k2_x*2.0 + k3_x*2.0 + k4_x)*(h/6), v + (k1_v + k2_v*2.0 + k3_v*2.0 + k4_v)*(h/6)};
+        }
+    };
+
+    // Yoshida's fourth order composition of three leapfrog steps. Symplectic like velocity Verlet, so the energy error
+    // stays bounded over long runs, at three force evaluations per step
+    struct yoshida4 {
+        template<typename X, typename V, typename A, typename T, typename H>
+        static constexpr auto step(X x, V v, A && a, T t, H h) -> std::pair<X, V> {
+            // w1 = 1 / (2 - 2^(1/3)), w0 = 1 - 2 * w1
+            constexpr auto w1 = 1.3512071919596578;
+            constexpr auto w0 = -1.7024143839193153;
+            constexpr auto c1 = w1 / 2;
+            constexpr auto c2 = (w0 + w1) / 2;
+
+            x = x + v*(h*c1);
+            v = v + a(t + h*c1, x, v)*(h*w1);
+            x = x + v*(h*c2);
+            v = v + a(t + h*(c1 + c2), x, v)*(h*w0);
+            x = x + v*(h*c2);
+            v = v + a(t + h*(c1 + 2*c2), x, v)*(h*w1);
+            x = x + v*(h*c1);
+            return {x, v};
+        }
+    };
+
+    template<typename X, typename V>
+    struct embedded_step {
+        X x;
+        V v;
+        // Difference between the fifth and the embedded fourth order solutions
+        X x_error;
+        V v_error;
+    };
+
+    // Dormand-Prince 5(4): a fifth order step with an embedded fourth order one, whose difference estimates the local error.
+    // Seven evaluations of a per step
+    struct dormand_prince {
+        template<typename X, typename V, typename A, typename T, typename H>
+        static constexpr auto step(X x, V v, A && a, T t, H h) -> embedded_step<X, V> {
+            auto const k1_x = v;
+            auto const k1_v = a(t, x, v);
+
+            auto const k2_x = v + k1_v*(h*(1.0/5));
+            auto const k2_v = a(t + h*(1.0/5), x + k1_x*(h*(1.0/5)), k2_x);
+
+            auto const k3_x = v + (k1_v*(3.0/40) + k2_v*(9.0/40))*h;
+            auto const k3_v = a(t + h*(3.0/10), x + (k1_x*(3.0/40) + k2_x*(9.0/40))*h, k3_x);
+
+            auto const k4_x = v + (k1_v*(44.0/45) + k2_v*(-56.0/15) + k3_v*(32.0/9))*h;
+            auto const k4_v = a(t + h*(4.0/5), x + (k1_x*(44.0/45) + k2_x*(-56.0/15) + k3_x*(32.0/9))*h, k4_x);
+
+            auto const k5_x = v + (k1_v*(19372.0/6561) + k2_v*(-25360.0/2187) + k3_v*(64448.0/6561) + k4_v*(-212.0/729))*h;
+            auto const k5_v = a(t + h*(8.0/9),
+                x + (k1_x*(19372.0/6561) + k2_x*(-25360.0/2187) + k3_x*(64448.0/6561) + k4_x*(-212.0/729))*h, k5_x);
+
+            auto const k6_x = v + (k1_v*(9017.0/3168) + k2_v*(-355.0/33) + k3_v*(46732.0/5247) + k4_v*(49.0/176) + k5_v*(-5103.0/18656))*h;
+            auto const k6_v = a(t + h,
+                x + (k1_x*(9017.0/3168) + k2_x*(-355.0/33) + k3_x*(46732.0/5247) + k4_x*(49.0/176) + k5_x*(-5103.0/18656))*h, k6_x);
+
+            auto const next_x = x + (k1_x*(35.0/384) + k3_x*(500.0/1113) + k4_x*(125.0/192) + k5_x*(-2187.0/6784) + k6_x*(11.0/84))*h;
+            auto const next_v = v + (k1_v*(35.0/384) + k3_v*(500.0/1113) + k4_v*(125.0/192) + k5_v*(-2187.0/6784) + k6_v*(11.0/84))*h;
+
+            auto const k7_x = next_v;
+            auto const k7_v = a(t + h, next_x, next_v);
+
+            auto const x_error = (k1_x*(71.0/57600) + k3_x*(-71.0/16695) + k4_x*(71.0/1920) + k5_x*(-17253.0/339200) + k6_x*(22.0/525) + k7_x*(-1.0/40))*h;
+            auto const v_error = (k1_v*(71.0/57600) + k3_v*(-71.0/16695) + k4_v*(71.0/1920) + k5_v*(-17253.0/339200) + k6_v*(22.0/525) + k7_v*(-1.0/40))*h;
+            return {next_x, next_v, x_error, v_error};
+        }
+    };
+
+    struct adaptive_settings {
+        // Steps whose error norm is above 1 are retried with a smaller step
+        double safety = 0.9;
+        double min_step = 1e-9;
+        double max_growth = 5.0;
+        double max_shrink = 0.2;
+    };
+
+    template<typename X, typename V>
+    struct adaptive_result {
+        X x;
+        V v;
+        // Step size to start the next call with
+        double step;
+        int accepted;
+        int rejected;
+    };
+
+    // Integrates from t over duration with dormand_prince steps, sizing each one from the previous error estimate.
+    // error_norm(x_error, v_error, x, v) should return the error relative to the tolerance, 1 being just acceptable.
+    // Steps are clamped to end exactly at t + duration, and a step shrunk to min_step is accepted whatever its error
+    template<typename X, typename V, typename A, typename N>
+    auto integrate_adaptive(X x, V v, A && a, double t, double duration, double step, N && error_norm, adaptive_settings const& settings = {}) -> adaptive_result<X, V> {
+        auto result = adaptive_result<X, V>{x, v, std::max(step, settings.min_step), 0, 0};
+        auto const end = t + duration;
+        while(t < end) {
+            auto const h = std::min(result.step, end - t);
+            auto const trial = dormand_prince::step(result.x, result.v, a, t, h);
+            auto const error = error_norm(trial.x_error, trial.v_error, trial.x, trial.v);
+
+            // Fifth root, since the embedded error estimate is fourth order in h
+            auto const factor = error > 0.0 ? settings.safety * std::pow(error, -0.2) : settings.max_growth;
+            auto const next_step = std::max(h * std::clamp(factor, settings.max_shrink, settings.max_growth), settings.min_step);
+            if(error > 1.0 && h > settings.min_step) {
+                result.step = next_step;
+                ++result.rejected;
+                continue;
+            }
+
+            result.x = trial.x;
+            result.v = trial.v;
+            ++result.accepted;
+            t = h < end - t ? t + h : end;
+            // A step cut short by the end of the interval says little about the next one
+            if(h == result.step || next_step < result.step) {
+                result.step = next_step;
+            }
+        }
+        return result;
+    }
+}
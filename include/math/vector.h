@@ -1,52 +1,87 @@
 #pragma once
 
 namespace hz::math {
-    struct vector2d {
-        double x, y;
+    namespace detail {
+        // Keeps scalar arguments out of deduction, so that vector2f * 2.0 means float math instead of a deduction conflict
+        template<typename T>
+        struct non_deduced {
+            using type = T;
+        };
+        template<typename T>
+        using non_deduced_t = typename non_deduced<T>::type;
+    }
+
+    template<typename T>
+    struct basic_vector2d {
+        using value_type = T;
 
-        constexpr auto operator+() const noexcept -> vector2d {
-            return vector2d{x, y};
+        T x, y;
+
+        constexpr auto operator+() const noexcept -> basic_vector2d {
+            return basic_vector2d{x, y};
         }
-        constexpr auto operator+=(vector2d other) noexcept -> vector2d & {
+        constexpr auto operator+=(basic_vector2d other) noexcept -> basic_vector2d & {
             x += other.x;
             y += other.y;
             return *this;
         }
-        constexpr auto operator-() const noexcept -> vector2d {
-            return vector2d{-x, -y};
+        constexpr auto operator-() const noexcept -> basic_vector2d {
+            return basic_vector2d{-x, -y};
         }
         
-        constexpr auto operator-=(vector2d other) noexcept -> vector2d & {
+        constexpr auto operator-=(basic_vector2d other) noexcept -> basic_vector2d & {
             x -= other.x;
             y -= other.y;
             return *this;
         }
         
-        constexpr auto operator==(vector2d other) const noexcept -> bool {
+        constexpr auto operator==(basic_vector2d other) const noexcept -> bool {
             return x == other.x && y == other.y;
         }
-        constexpr auto operator!=(vector2d other) const noexcept -> bool {
+        constexpr auto operator!=(basic_vector2d other) const noexcept -> bool {
             return !(*this == other);
         }
     };
 
-    inline constexpr auto operator+(vector2d lhs, vector2d rhs) noexcept -> vector2d {
-        return vector2d{lhs.x + rhs.x, lhs.y + rhs.y};
+    using vector2d = basic_vector2d<double>;
+    // Half the memory of vector2d, and twice the lanes per SIMD register
+    using vector2f = basic_vector2d<float>;
+
+    template<typename T>
+    inline constexpr auto operator+(basic_vector2d<T> lhs, basic_vector2d<T> rhs) noexcept -> basic_vector2d<T> {
+        return basic_vector2d<T>{lhs.x + rhs.x, lhs.y + rhs.y};
     }
-    constexpr auto operator-(vector2d lhs, vector2d rhs) noexcept -> vector2d {
-        return vector2d{lhs.x - rhs.x, lhs.y - rhs.y};
+    template<typename T>
+    constexpr auto operator-(basic_vector2d<T> lhs, basic_vector2d<T> rhs) noexcept -> basic_vector2d<T> {
+        return basic_vector2d<T>{lhs.x - rhs.x, lhs.y - rhs.y};
     }
-    inline constexpr auto operator*(vector2d lhs, double rhs) noexcept -> vector2d {
-        return vector2d{lhs.x * rhs, lhs.y * rhs};
+    template<typename T>
+    inline constexpr auto operator*(basic_vector2d<T> lhs, detail::non_deduced_t<T> rhs) noexcept -> basic_vector2d<T> {
+        return basic_vector2d<T>{lhs.x * rhs, lhs.y * rhs};
     }
-    inline constexpr auto operator*(double lhs, vector2d rhs) noexcept -> vector2d {
-        return vector2d{lhs * rhs.x, lhs * rhs.y};
+    template<typename T>
+    inline constexpr auto operator*(detail::non_deduced_t<T> lhs, basic_vector2d<T> rhs) noexcept -> basic_vector2d<T> {
+        return basic_vector2d<T>{lhs * rhs.x, lhs * rhs.y};
     }
-    inline constexpr auto operator/(vector2d lhs, double rhs) noexcept -> vector2d {
-        return vector2d{lhs.x / rhs, lhs.y / rhs};
+    template<typename T>
+    inline constexpr auto operator/(basic_vector2d<T> lhs, detail::non_deduced_t<T> rhs) noexcept -> basic_vector2d<T> {
+        return basic_vector2d<T>{lhs.x / rhs, lhs.y / rhs};
+    }
+
+    // Converts between scalar types, e.g. vector_cast<float>(v) to store a vector2d as a vector2f
+    template<typename U, typename T>
+    constexpr auto vector_cast(basic_vector2d<T> v) noexcept -> basic_vector2d<U> {
+        return basic_vector2d<U>{static_cast<U>(v.x), static_cast<U>(v.y)};
+    }
+
+    // Linear interpolation: from at t = 0, to at t = 1
+    template<typename T>
+    constexpr auto lerp(basic_vector2d<T> from, basic_vector2d<T> to, detail::non_deduced_t<T> t) noexcept -> basic_vector2d<T> {
+        return from + (to - from) * t;
     }
 
-    constexpr auto scalar_product(vector2d lhs, vector2d rhs) -> double {
+    template<typename T>
+    constexpr auto scalar_product(basic_vector2d<T> lhs, basic_vector2d<T> rhs) -> T {
         return lhs.x*rhs.x + lhs.y*rhs.y;
     }
 }
@@ -0,0 +1,100 @@
+#pragma once
+
+#include <algorithm>
+#include <memory>
+#include <typeindex>
+#include <vector>
+
+#include "common/range/view.h"
+#include "common/thread/job_pool.h"
+#include "model/entity.h"
+
+namespace hz::model {
+    // Sorted component types of an entity. Duplicates are kept, so that an entity with two components of one type gets its own archetype
+    using archetype_signature = std::vector<std::type_index>;
+
+    inline auto make_signature(range::contiguous_view<entity_component const> components) -> archetype_signature {
+        auto signature = archetype_signature();
+        signature.reserve(components.size());
+        for(auto const& component : components) {
+            signature.push_back(component.get_type());
+        }
+        std::sort(signature.begin(), signature.end());
+        return signature;
+    }
+
+    // Group of the entities sharing one component set, with one column per component type
+    class archetype {
+    public:
+        archetype(archetype_signature signature, range::contiguous_view<entity_component const> components)
+            : signature(std::move(signature)) {
+            for(auto const& component : components) {
+                if(find_column(component.get_type()) == nullptr) {
+                    columns.push_back(component.make_column());
+                }
+            }
+        }
+        archetype(archetype const& other)
+            : signature(other.signature) {
+            columns.reserve(other.columns.size());
+            for(auto const& column : other.columns) {
+                columns.push_back(column->clone());
+            }
+        }
+        archetype(archetype &&) = default;
+        auto operator=(archetype const& other) -> archetype & {
+            return *this = archetype(other);
+        }
+        auto operator=(archetype &&) -> archetype & = default;
+        ~archetype() = default;
+
+        auto get_signature() const noexcept -> archetype_signature const& {
+            return signature;
+        }
+
+        void add(std::size_t owner, range::contiguous_view<entity_component> components) {
+            for(auto & component : components) {
+                component.move_into(*find_column(component.get_type()), owner);
+            }
+        }
+
+        void on_update(range::contiguous_view<entity> entities, input::event_state_t const& input, physics::tick_time time) {
+            for(auto const& column : columns) {
+                column->on_update(entities, input, time);
+            }
+        }
+
+        // Columns run one after the other, each split in chunks across the pool
+        void on_update(range::contiguous_view<entity> entities, input::event_state_t const& input, physics::tick_time time, thread::job_pool & pool, std::ptrdiff_t chunk_size) {
+            for(auto const& column : columns) {
+                pool.parallel_for(0, column->size(), chunk_size, [&] (std::ptrdiff_t begin, std::ptrdiff_t end) {
+                    column->on_update(entities, begin, end, input, time);
+                });
+            }
+        }
+
+        void hash_state(hash::state_hasher & hasher) const {
+            for(auto const& column : columns) {
+                column->hash_state(hasher);
+            }
+        }
+
+        template<typename T>
+        auto get_column() noexcept -> component_column_impl<T> * {
+            return static_cast<component_column_impl<T>*>(find_column(typeid(T)));
+        }
+        template<typename T>
+        auto get_column() const noexcept -> component_column_impl<T> const* {
+            return static_cast<component_column_impl<T> const*>(find_column(typeid(T)));
+        }
+
+    private:
+        auto find_column(std::type_index type) const noexcept -> component_column * {
+            auto const it = std::find_if(columns.begin(), columns.end(), [type] (auto const& column) { return column->get_type() == type; });
+            return it != columns.end() ? it->get() : nullptr;
+        }
+
+        archetype_signature signature;
+        std::vector<std::unique_ptr<component_column>> columns;
+    };
+}
@@ -1,15 +1,64 @@
 #pragma once
 
 #include <any>
+#include <cstddef>
+#include <new>
+#include <memory>
 #include <vector>
 #include <typeinfo>
+#include <typeindex>
 
+#include <gsl/gsl_assert>
+
+#include "common/hash/state_hasher.h"
+#include "common/range/view.h"
 #include "input/event.h"
+#include "meta/detected.h"
 #include "physics/time.h"
-#include "physics/body.h"
+#include "physics/body_storage.h"
 
 namespace hz::model {
     class entity;
+    class component_column;
+    template<typename T>
+    class component_column_impl;
+
+    namespace detail {
+        template<typename U>
+        using update_method_event_tick_t = decltype(std::declval<U>().on_update(std::declval<entity&>(), std::declval<input::event_state_t>(), std::declval<physics::tick_time>()));
+        template<typename U>
+        using update_method_tick_t = decltype(std::declval<U>().on_update(std::declval<entity&>(), std::declval<physics::tick_time>()));
+        template<typename U>
+        using update_method_event_seconds_t = decltype(std::declval<U>().on_update(std::declval<entity&>(), std::declval<input::event_state_t>(), std::declval<physics::seconds>()));
+        template<typename U>
+        using update_method_event_t = decltype(std::declval<U>().on_update(std::declval<entity&>(), std::declval<input::event_state_t>()));
+        template<typename U>
+        using update_method_seconds_t = decltype(std::declval<U>().on_update(std::declval<entity&>(), std::declval<physics::seconds>()));
+        template<typename U>
+        using update_method_empty_t = decltype(std::declval<U>().on_update(std::declval<entity&>()));
+
+        template<typename U>
+        using hash_state_method_t = decltype(std::declval<U const&>().hash_state(std::declval<hash::state_hasher&>()));
+    }
+
+    // Calls whichever on_update overload the component provides. The tick overloads are looked for first, since a
+    // tick_time parameter also accepts a bare time step
+    template<typename T>
+    void update_component(T & data, entity & e, input::event_state_t const& input, physics::tick_time time) {
+        if constexpr(meta::is_detected<detail::update_method_event_tick_t, T>::value) {
+            data.on_update(e, input, time);
+        } else if constexpr(meta::is_detected<detail::update_method_tick_t, T>::value) {
+            data.on_update(e, time);
+        } else if constexpr(meta::is_detected<detail::update_method_event_seconds_t, T>::value) {
+            data.on_update(e, input, time.dt);
+        } else if constexpr(meta::is_detected<detail::update_method_event_t, T>::value) {
+            data.on_update(e, input);
+        } else if constexpr(meta::is_detected<detail::update_method_seconds_t, T>::value) {
+            data.on_update(e, time.dt);
+        } else if constexpr(meta::is_detected<detail::update_method_empty_t, T>::value) {
+            data.on_update(e);
+        }
+    }
 
     class entity_component {
     public:
@@ -20,21 +69,49 @@ namespace hz::model {
 
         }
 
-        void on_update(entity & entity, input::event_state_t const& input, physics::seconds dt) {
-            component_data->on_update(entity, input, dt);
+        void on_update(entity & entity, input::event_state_t const& input, physics::tick_time time) {
+            component_data->on_update(entity, input, time);
         }
 
         auto get_name() const noexcept -> std::string_view {
             return name;
         }
 
+        auto get_type() const noexcept -> std::type_index {
+            return component_data->get_type();
+        }
+
+        // Creates an empty column able to hold this component's type
+        auto make_column() const -> std::unique_ptr<component_column> {
+            return component_data->make_column();
+        }
+
+        // Moves the component data to the end of a column made by make_column. The component is left in a moved-from state
+        void move_into(component_column & column, std::size_t owner) {
+            component_data->move_into(column, owner);
+        }
+
     private:
         class component_interface {
         public:
-            virtual auto clone() -> std::unique_ptr<component_interface> = 0;
-            virtual void on_update(entity & entity, input::event_state_t const& input, physics::seconds dt) = 0;
+            virtual ~component_interface() = default;
+            // Copies into the buffer when the type is stored inline, otherwise on the heap
+            virtual auto copy_to(void * buffer) const -> component_interface * = 0;
+            // Only called on inline components
+            virtual auto move_to(void * buffer) noexcept -> component_interface * = 0;
+            virtual void on_update(entity & entity, input::event_state_t const& input, physics::tick_time time) = 0;
+            virtual auto get_type() const noexcept -> std::type_index = 0;
+            virtual auto make_column() const -> std::unique_ptr<component_column> = 0;
+            virtual void move_into(component_column & column, std::size_t owner) = 0;
         };
 
+        static constexpr std::size_t inline_size = 48;
+
+        template<typename Impl>
+        static constexpr bool fits_inline = sizeof(Impl) <= inline_size
+            && alignof(Impl) <= alignof(std::max_align_t)
+            && std::is_nothrow_move_constructible_v<Impl>;
+
         template<typename T>
         class component_impl : public component_interface {
         public:
@@ -44,73 +121,120 @@ namespace hz::model {
 
             }
 
-            virtual auto clone() -> std::unique_ptr<component_interface> {
-                return std::make_unique<component_impl>(component_impl{data});
+            virtual auto copy_to(void * buffer) const -> component_interface * override {
+                if constexpr(fits_inline<component_impl>) {
+                    return new (buffer) component_impl(*this);
+                } else {
+                    (void)buffer;
+                    return new component_impl(*this);
+                }
             }
 
-            template<typename U>
-            using update_method_event_seconds_t = decltype(std::declval<U>().on_update(std::declval<entity&>(), std::declval<input::event_state_t>(), std::declval<seconds>()));
-            template<typename U>
-            using update_method_event_t = decltype(std::declval<U>().on_update(std::declval<entity&>(), std::declval<input::event_state_t>()));
-            template<typename U>
-            using update_method_seconds_t = decltype(std::declval<U>().on_update(std::declval<entity&>(), std::declval<physics::seconds>()));
-            template<typename U>
-            using update_method_empty_t = decltype(std::declval<U>().on_update(std::declval<entity&>()));
-
-            virtual void on_update(entity & e, input::event_state_t const& input, physics::seconds dt) override {
-                if constexpr(meta::is_detected<update_method_event_seconds_t, T>::value) {
-                    data.on_update(e, input, dt);
-                } else if constexpr(meta::is_detected<update_method_event_t, T>::value) {
-                    data.on_update(e, input);
-                } else if constexpr(meta::is_detected<update_method_seconds_t, T>::value) {
-                    data.on_update(e, dt);
-                } else if constexpr(meta::is_detected<update_method_empty_t, T>::value) {
-                    data.on_update(e);
+            virtual auto move_to(void * buffer) noexcept -> component_interface * override {
+                if constexpr(fits_inline<component_impl>) {
+                    return new (buffer) component_impl(std::move(*this));
+                } else {
+                    // Heap components move by handing over their pointer in component_holder::move_from, never through here
+                    (void)buffer;
+                    Expects(false);
+                    return nullptr;
                 }
             }
 
+            virtual void on_update(entity & e, input::event_state_t const& input, physics::tick_time time) override {
+                update_component(data, e, input, time);
+            }
+
+            virtual auto get_type() const noexcept -> std::type_index override {
+                return typeid(T);
+            }
+
+            virtual auto make_column() const -> std::unique_ptr<component_column> override {
+                return std::make_unique<component_column_impl<T>>();
+            }
+
+            virtual void move_into(component_column & column, std::size_t owner) override {
+                static_cast<component_column_impl<T>&>(column).push_back(std::move(data), owner);
+            }
+
         private:
             T data;
         };
 
+        // Small nothrow-movable components live in an inline buffer, larger ones on the heap
         class component_holder {
         public:
             component_holder() = default;
-            component_holder(component_holder const& other)
-                : component_data(other.component_data->clone()) {
-
+            component_holder(component_holder const& other) {
+                copy_from(other);
             }
-            component_holder(component_holder && other)
-                : component_data(std::move(other.component_data)) {
-
+            component_holder(component_holder && other) noexcept {
+                move_from(other);
             }
+            // Copies before releasing the current component, so that a throwing copy leaves it untouched
             auto operator=(component_holder const& other) -> component_holder & {
-                component_data = other.component_data->clone();
-                return *this;
+                auto copy = component_holder(other);
+                return *this = std::move(copy);
             }
-            auto operator=(component_holder && other) -> component_holder & {
-                component_data = std::move(other.component_data);
+            auto operator=(component_holder && other) noexcept -> component_holder & {
+                if(this != &other) {
+                    reset();
+                    move_from(other);
+                }
                 return *this;
             }
-            ~component_holder() = default;
+            ~component_holder() {
+                reset();
+            }
 
             template<typename InputT>
-            component_holder(InputT&& input) 
-                : component_data(make_component_data(std::forward<InputT>(input))){
-
+            component_holder(InputT&& input) {
+                using impl = component_impl<std::decay_t<InputT>>;
+                if constexpr(fits_inline<impl>) {
+                    component_data = new (&buffer) impl(std::forward<InputT>(input));
+                    is_inline = true;
+                } else {
+                    component_data = new impl(std::forward<InputT>(input));
+                }
             }
-            
+
             auto operator->() -> component_interface* {
-                return component_data.get();
+                return component_data;
+            }
+            auto operator->() const -> component_interface const* {
+                return component_data;
             }
         private:
-            template<typename InputT>
-            static auto make_component_data(InputT&& input) -> std::unique_ptr<component_interface> {
-                using impl = component_impl<std::decay_t<InputT>>;
-                return std::make_unique<impl>(std::forward<InputT>(input));
+            void copy_from(component_holder const& other) {
+                if(other.component_data != nullptr) {
+                    component_data = other.component_data->copy_to(&buffer);
+                    is_inline = other.is_inline;
+                }
+            }
+
+            void move_from(component_holder & other) noexcept {
+                if(other.is_inline) {
+                    component_data = other.component_data->move_to(&buffer);
+                    is_inline = true;
+                    other.reset();
+                } else {
+                    component_data = std::exchange(other.component_data, nullptr);
+                }
             }
 
-            std::unique_ptr<component_interface> component_data;
+            void reset() noexcept {
+                if(is_inline) {
+                    component_data->~component_interface();
+                } else {
+                    delete component_data;
+                }
+                component_data = nullptr;
+                is_inline = false;
+            }
+
+            alignas(std::max_align_t) unsigned char buffer[inline_size];
+            component_interface * component_data = nullptr;
+            bool is_inline = false;
         };
 
         component_holder component_data;
@@ -119,10 +243,130 @@ namespace hz::model {
 
     enum class id : int { };
 
+    // Components are only held by the entity until it is added to a world, which moves them into its archetype columns
     class entity {
     public:
-        physics::body2d body;
+        physics::body2d_ref body;
         std::vector<entity_component> components;
         id id;
     };
-}
\ No newline at end of file
+
+    // Contiguous array of components of one type, along with the index of the entity owning each element
+    template<typename T>
+    class component_array {
+    public:
+        template<typename InputT>
+        void push_back(InputT && value, std::size_t owner) {
+            data.push_back(std::forward<InputT>(value));
+            owners.push_back(owner);
+        }
+
+        void on_update(range::contiguous_view<entity> entities, input::event_state_t const& input, physics::tick_time time) {
+            for(std::size_t i = 0; i < data.size(); ++i) {
+                update_component(data[i], entities[owners[i]], input, time);
+            }
+        }
+
+        // Updates the elements whose owner first appears in [begin, end). Components of one entity are adjacent, so moving both
+        // bounds past an owner's run keeps each entity in a single chunk when the array is updated in parallel chunks
+        void on_update(range::contiguous_view<entity> entities, std::size_t begin, std::size_t end, input::event_state_t const& input, physics::tick_time time) {
+            auto const skip_run = [this] (std::size_t i) {
+                while(i > 0 && i < owners.size() && owners[i] == owners[i - 1]) {
+                    ++i;
+                }
+                return i;
+            };
+            for(auto i = skip_run(begin), last = skip_run(end); i < last; ++i) {
+                update_component(data[i], entities[owners[i]], input, time);
+            }
+        }
+
+        // Only components that opt in with a hash_state(hash::state_hasher&) const method take part in state checksums
+        void hash_state(hash::state_hasher & hasher) const {
+            if constexpr(meta::is_detected<detail::hash_state_method_t, T>::value) {
+                for(auto const& component : data) {
+                    component.hash_state(hasher);
+                }
+            } else {
+                (void)hasher;
+            }
+        }
+
+        auto size() const noexcept -> std::size_t {
+            return data.size();
+        }
+
+        auto get_data() noexcept -> range::contiguous_view<T> {
+            return data;
+        }
+        auto get_data() const noexcept -> range::contiguous_view<T const> {
+            return data;
+        }
+        auto get_owners() const noexcept -> range::contiguous_view<std::size_t const> {
+            return owners;
+        }
+
+    private:
+        std::vector<T> data;
+        std::vector<std::size_t> owners;
+    };
+
+    // Type-erased component_array, one per component type in an archetype
+    class component_column {
+    public:
+        virtual ~component_column() = default;
+        virtual auto clone() const -> std::unique_ptr<component_column> = 0;
+        virtual auto get_type() const noexcept -> std::type_index = 0;
+        virtual void on_update(range::contiguous_view<entity> entities, input::event_state_t const& input, physics::tick_time time) = 0;
+        virtual void on_update(range::contiguous_view<entity> entities, std::size_t begin, std::size_t end, input::event_state_t const& input, physics::tick_time time) = 0;
+        virtual void hash_state(hash::state_hasher & hasher) const = 0;
+        virtual auto size() const noexcept -> std::size_t = 0;
+        virtual auto get_owners() const noexcept -> range::contiguous_view<std::size_t const> = 0;
+    };
+
+    template<typename T>
+    class component_column_impl : public component_column {
+    public:
+        void push_back(T && value, std::size_t owner) {
+            components.push_back(std::move(value), owner);
+        }
+
+        virtual auto clone() const -> std::unique_ptr<component_column> override {
+            return std::make_unique<component_column_impl>(*this);
+        }
+
+        virtual auto get_type() const noexcept -> std::type_index override {
+            return typeid(T);
+        }
+
+        virtual void on_update(range::contiguous_view<entity> entities, input::event_state_t const& input, physics::tick_time time) override {
+            components.on_update(entities, input, time);
+        }
+
+        virtual void on_update(range::contiguous_view<entity> entities, std::size_t begin, std::size_t end, input::event_state_t const& input, physics::tick_time time) override {
+            components.on_update(entities, begin, end, input, time);
+        }
+
+        virtual void hash_state(hash::state_hasher & hasher) const override {
+            components.hash_state(hasher);
+        }
+
+        virtual auto size() const noexcept -> std::size_t override {
+            return components.size();
+        }
+
+        virtual auto get_owners() const noexcept -> range::contiguous_view<std::size_t const> override {
+            return components.get_owners();
+        }
+
+        auto get_data() noexcept -> range::contiguous_view<T> {
+            return components.get_data();
+        }
+        auto get_data() const noexcept -> range::contiguous_view<T const> {
+            return components.get_data();
+        }
+
+    private:
+        component_array<T> components;
+    };
+}
@@ -0,0 +1,72 @@
+#pragma once
+
+#include <vector>
+
+#include "common/range/view.h"
+#include "model/entity.h"
+#include "physics/body_storage.h"
+
+namespace hz::model {
+    // Entities and their bodies, index-aligned: entity i owns body i. Entities' body references are rebound whenever the storage moves
+    class entity_table {
+    public:
+        entity_table() = default;
+        entity_table(entity_table const& other)
+            : entities(other.entities)
+            , bodies(other.bodies) {
+            bind_bodies();
+        }
+        entity_table(entity_table && other) noexcept
+            : entities(std::move(other.entities))
+            , bodies(std::move(other.bodies)) {
+            bind_bodies();
+        }
+        auto operator=(entity_table const& other) -> entity_table & {
+            entities = other.entities;
+            bodies = other.bodies;
+            bind_bodies();
+            return *this;
+        }
+        auto operator=(entity_table && other) noexcept -> entity_table & {
+            entities = std::move(other.entities);
+            bodies = std::move(other.bodies);
+            bind_bodies();
+            return *this;
+        }
+        ~entity_table() = default;
+
+        auto add(entity e, physics::body2d const& body) -> std::size_t {
+            e.body = bodies[bodies.push_back(body)];
+            entities.push_back(std::move(e));
+            return entities.size() - 1;
+        }
+
+        auto size() const noexcept -> std::size_t {
+            return entities.size();
+        }
+
+        auto get_entities() noexcept -> range::contiguous_view<entity> {
+            return entities;
+        }
+        auto get_entities() const noexcept -> range::contiguous_view<entity const> {
+            return entities;
+        }
+
+        auto get_bodies() noexcept -> physics::body_storage2d & {
+            return bodies;
+        }
+        auto get_bodies() const noexcept -> physics::body_storage2d const& {
+            return bodies;
+        }
+
+    private:
+        void bind_bodies() noexcept {
+            for(std::size_t i = 0; i < entities.size(); ++i) {
+                entities[i].body = bodies[i];
+            }
+        }
+
+        std::vector<entity> entities;
+        physics::body_storage2d bodies;
+    };
+}
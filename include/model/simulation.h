@@ -0,0 +1,220 @@
+#pragma once
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <limits>
+#include <memory>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include "common/hash/state_hasher.h"
+#include "common/profile/profiler.h"
+#include "common/range/view.h"
+#include "common/thread/job_pool.h"
+#include "common/thread/triple_buffer.h"
+#include "input/event.h"
+#include "math/vector.h"
+#include "model/entity.h"
+#include "model/world.h"
+#include "physics/body.h"
+#include "physics/collision_system.h"
+#include "physics/integrate_batch.h"
+#include "physics/sleep.h"
+#include "physics/time.h"
+
+namespace hz::model {
+    // Body state the renderer needs, copied column by column out of the world around each tick.
+    // Positions from before and after the tick let the renderer blend between the two.
+    // Single precision is plenty at screen scale, and halves what each tick copies
+    struct body_snapshot {
+        std::vector<physics::basic_position2d<float>> previous_positions;
+        std::vector<physics::basic_position2d<float>> positions;
+        std::vector<math::vector2f> dimensions;
+    };
+
+    using snapshot_buffer = thread::triple_buffer<body_snapshot>;
+
+    struct game_model {
+        world model;
+        physics::collision_system collisions;
+        physics::sleep_system sleeping;
+        std::unique_ptr<snapshot_buffer> snapshots;
+        hash::checksum_stream checksums = hash::checksum_stream();
+        std::uint64_t tick = 0;
+    };
+
+    inline constexpr auto collision_cell_size = 4.0;
+    inline constexpr auto component_chunk_size = 1024;
+    inline constexpr auto body_chunk_size = 4096;
+    inline constexpr auto default_tick_rate = 60u;
+    inline constexpr auto tick_duration = physics::seconds(1.0 / default_tick_rate);
+
+    class player_input {
+    public:
+        void on_update(entity & entity, input::event_state_t const& input) {
+            keys.update(input);
+
+            auto force = physics::force2d();
+            if(keys.is_up_held()) force += physics::force2d(0, input_force);
+            if(keys.is_down_held()) force += physics::force2d(0, -input_force);
+            if(keys.is_left_held()) force += physics::force2d(-input_force, 0);
+            if(keys.is_right_held()) force += physics::force2d(input_force, 0);
+            if(force.value != math::vector2d()) {
+                entity.body.wake();
+            }
+            entity.body.add_force(force);
+        }
+
+        double input_force = 20.0;
+
+    private:
+        input::held_keys keys;
+    };
+
+    class gravity_component {
+    public:
+        void on_update(entity & entity) {
+            entity.body.add_acceleration(physics::acceleration2d(0.0, -10.0));
+        }
+    };
+
+    inline constexpr auto box_spacing = 2.0;
+
+    inline auto get_box_grid_width(std::size_t box_count) -> double {
+        return std::ceil(std::sqrt(static_cast<double>(box_count))) * box_spacing;
+    }
+
+    // Boxes are stacked in a square grid above the floor
+    inline auto get_box_position(std::size_t box, std::size_t box_count) -> physics::position2d {
+        auto const columns = static_cast<std::size_t>(std::ceil(std::sqrt(static_cast<double>(box_count))));
+        return physics::position2d(
+            (static_cast<double>(box % columns) + 0.5) * box_spacing - get_box_grid_width(box_count) / 2,
+            -26.0 + static_cast<double>(box / columns) * box_spacing);
+    }
+
+    // The player and the floor are always bodies 0 and 1, followed by box_count boxes whose entities come from
+    // make_box(box index). The floor widens to hold the boxes
+    template<typename F>
+    auto init_model(std::size_t box_count, F && make_box) -> game_model {
+        auto test_entity = entity();
+        test_entity.components.push_back(gravity_component());
+        test_entity.components.push_back(player_input());
+
+        auto floor_body = physics::body2d();
+        floor_body.position = physics::position2d(0.0, -30.0);
+        floor_body.dimension = {std::max(90.0, get_box_grid_width(box_count) + 10.0), 4.0};
+        floor_body.weight = {std::numeric_limits<double>::infinity()};
+
+        auto w = world();
+        w.add_entity(std::move(test_entity));
+        w.add_entity(entity(), floor_body);
+        for(std::size_t i = 0; i < box_count; ++i) {
+            auto box_body = physics::body2d();
+            box_body.position = get_box_position(i, box_count);
+            box_body.dimension = {1.0, 1.0};
+            w.add_entity(make_box(i), box_body);
+        }
+        return game_model{std::move(w), physics::collision_system(collision_cell_size), physics::sleep_system(), std::make_unique<snapshot_buffer>()};
+    }
+
+    // Boxes fall under gravity
+    inline auto init_model(std::size_t box_count = 0) -> game_model {
+        return init_model(box_count, [] (std::size_t) {
+            auto box = entity();
+            box.components.push_back(gravity_component());
+            return box;
+        });
+    }
+
+    inline auto default_worker_count() -> std::size_t {
+        auto const hardware_threads = std::thread::hardware_concurrency();
+        return hardware_threads > 1 ? hardware_threads - 1 : 0;
+    }
+
+    // Sleeping bodies take no forces, so only the awake bodies need integrating and clearing, chunked by the active list.
+    // Returns a checksum of the resulting world state, to compare runs tick by tick
+    inline auto update_entities(world & world, physics::collision_system & collisions, physics::sleep_system & sleeping, thread::job_pool & pool, input::event_state_t const& input, physics::tick_time time) -> std::uint64_t {
+        HZ_PROFILE_ZONE("update_entities");
+        {
+            HZ_PROFILE_ZONE("update_components");
+            world.update_components(input, time, pool, component_chunk_size);
+        }
+
+        auto & bodies = world.get_bodies();
+        sleeping.wake_flagged(bodies);
+        // Bodies that move this tick are the ones awake now, and those woken by contacts during the step
+        auto const mark_awake_changed = [&world, &sleeping, &bodies] {
+            sleeping.for_each_awake_run(0, bodies.size(), [&world] (std::size_t begin, std::size_t end) { world.mark_bodies_changed(begin, end); });
+        };
+        mark_awake_changed();
+
+        auto const positions = bodies.get_positions();
+        auto const velocities = bodies.get_velocities();
+        auto const accelerations = bodies.get_accelerations();
+        auto const active = sleeping.get_active();
+        pool.parallel_for(0, active.size(), body_chunk_size, [&] (std::ptrdiff_t chunk_begin, std::ptrdiff_t chunk_end) {
+            HZ_PROFILE_ZONE("integrate");
+            sleeping.for_each_active_run(chunk_begin, chunk_end, [&] (std::ptrdiff_t begin, std::ptrdiff_t end) {
+                auto const count = end - begin;
+                physics::integrate_batch(positions.subspan(begin, count), velocities.subspan(begin, count), accelerations.subspan(begin, count), time.dt);
+                std::fill(accelerations.begin() + begin, accelerations.begin() + end, physics::acceleration2d());
+            });
+        });
+
+        {
+            HZ_PROFILE_ZONE("collisions");
+            collisions.step(bodies, sleeping.get_active());
+        }
+        {
+            HZ_PROFILE_ZONE("sleeping");
+            sleeping.update(bodies, collisions.get_contacts());
+        }
+        mark_awake_changed();
+
+        HZ_PROFILE_ZONE("hash_state");
+        auto hasher = hash::state_hasher();
+        world.hash_changed_state(hasher, pool);
+        return hasher.digest();
+    }
+
+    // One tick without publishing a snapshot, for runs nobody watches. Components see the model's tick index.
+    // Returns the checksum of the resulting state, also kept in the model's checksum stream
+    inline auto advance_tick(game_model & model, thread::job_pool & pool, input::event_state_t const& input, physics::seconds dt) -> std::uint64_t {
+        auto const checksum = update_entities(model.model, model.collisions, model.sleeping, pool, input, {dt, model.tick});
+        model.checksums.push(model.tick, checksum);
+        ++model.tick;
+        return checksum;
+    }
+
+    // Every body asleep, so ticks change nothing until input or a component wakes one. Not before the first tick,
+    // when the sleep system has yet to see the bodies
+    inline auto is_at_rest(game_model const& model) noexcept -> bool {
+        return model.tick > 0 && model.sleeping.get_awake_count() == 0;
+    }
+
+    inline void store_positions(range::contiguous_view<physics::position2d const> from, std::vector<physics::basic_position2d<float>> & to) {
+        to.resize(from.size());
+        std::transform(from.begin(), from.end(), to.begin(), [] (physics::position2d p) {
+            return physics::basic_position2d<float>(math::vector_cast<float>(p.value));
+        });
+    }
+
+    // Call before the last tick of a frame, so that rendering blends from the positions before that tick
+    inline void store_previous_positions(game_model & model) {
+        store_positions(std::as_const(model.model).get_bodies().get_positions(), model.snapshots->get_write_buffer().previous_positions);
+    }
+
+    // Call once per frame after its ticks, however many it caught up on, so that only the last tick is copied out
+    inline void publish_snapshot(game_model & model) {
+        auto & bodies = std::as_const(model.model).get_bodies();
+        auto & snapshot = model.snapshots->get_write_buffer();
+        store_positions(bodies.get_positions(), snapshot.positions);
+        auto const dimensions = bodies.get_dimensions();
+        snapshot.dimensions.resize(dimensions.size());
+        std::transform(dimensions.begin(), dimensions.end(), snapshot.dimensions.begin(), [] (math::vector2d d) { return math::vector_cast<float>(d); });
+        model.snapshots->publish();
+    }
+}
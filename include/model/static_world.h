@@ -0,0 +1,60 @@
+#pragma once
+
+#include <tuple>
+#include <type_traits>
+
+#include "common/range/view.h"
+#include "model/entity.h"
+#include "model/entity_table.h"
+#include "physics/body_storage.h"
+
+namespace hz::model {
+    // World whose component types are fixed at compile time. Each type gets its own component_array, and updates
+    // go straight through update_component without any virtual dispatch. Types update in the order they are listed
+    template<typename... Components>
+    class static_world {
+    public:
+        template<typename T>
+        static constexpr bool has_component = (std::is_same_v<T, Components> || ...);
+
+        template<typename... InputT>
+        auto add_entity(physics::body2d const& body, InputT&&... components) -> static_world & {
+            static_assert((has_component<std::decay_t<InputT>> && ...), "Component type is not part of this world");
+            auto const index = table.add(entity(), body);
+            (get_components<std::decay_t<InputT>>().push_back(std::forward<InputT>(components), index), ...);
+            return *this;
+        }
+
+        void update_components(input::event_state_t const& input, physics::tick_time time) {
+            auto const entities = table.get_entities();
+            std::apply([&] (auto &... arrays) { (arrays.on_update(entities, input, time), ...); }, components);
+        }
+
+        template<typename T>
+        auto get_components() noexcept -> component_array<T> & {
+            return std::get<component_array<T>>(components);
+        }
+        template<typename T>
+        auto get_components() const noexcept -> component_array<T> const& {
+            return std::get<component_array<T>>(components);
+        }
+
+        auto get_entities() noexcept -> range::contiguous_view<entity> {
+            return table.get_entities();
+        }
+        auto get_entities() const noexcept -> range::contiguous_view<entity const> {
+            return table.get_entities();
+        }
+
+        auto get_bodies() noexcept -> physics::body_storage2d & {
+            return table.get_bodies();
+        }
+        auto get_bodies() const noexcept -> physics::body_storage2d const& {
+            return table.get_bodies();
+        }
+
+    private:
+        entity_table table;
+        std::tuple<component_array<Components>...> components;
+    };
+}
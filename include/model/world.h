@@ -1,7 +1,16 @@
 #pragma once
 
+#include <algorithm>
+#include <cstdint>
+#include <vector>
+
+#include "common/hash/state_hasher.h"
 #include "common/range/view.h"
+#include "common/thread/job_pool.h"
+#include "model/archetype.h"
 #include "model/entity.h"
+#include "model/entity_table.h"
+#include "physics/body_storage.h"
 
 namespace hz::model {
     class world;
@@ -10,23 +19,159 @@ namespace hz::model {
 
     };
 
+    // Components are grouped by archetype, so that updates walk one contiguous array per component type
     class world {
     public:
-        template<typename... Args>
-        auto add_entity(Args&&... args) -> world & {
-            entities.emplace_back(args...);
+        // Moves the entity's components into the columns of its archetype
+        auto add_entity(entity e, physics::body2d const& body = {}) -> world & {
+            auto const index = table.size();
+            get_archetype(e.components).add(index, e.components);
+            e.components.clear();
+            table.add(std::move(e), body);
             return *this;
         }
 
+        void update_components(input::event_state_t const& input, physics::tick_time time) {
+            for(auto & archetype : archetypes) {
+                archetype.on_update(table.get_entities(), input, time);
+            }
+        }
+
+        // Same as update_components, with each component column split in chunks run on the pool.
+        // Components may then only modify their own entity
+        void update_components(input::event_state_t const& input, physics::tick_time time, thread::job_pool & pool, std::ptrdiff_t chunk_size) {
+            for(auto & archetype : archetypes) {
+                archetype.on_update(table.get_entities(), input, time, pool, chunk_size);
+            }
+        }
+
+        // Calls f(contiguous_view<T>, contiguous_view<std::size_t const> owners) once per archetype containing T
+        template<typename T, typename F>
+        void for_each_column(F && f) {
+            for(auto & archetype : archetypes) {
+                if(auto const column = archetype.get_column<T>()) {
+                    f(column->get_data(), column->get_owners());
+                }
+            }
+        }
+
+        // Hashes the state that evolves from tick to tick: body positions, velocities and awake flags, then the components
+        // that opt in, archetype by archetype. Body parameters are left out, since any divergence in them shows up in the
+        // positions within a tick. Bodies are hashed in fixed chunks whose digests are folded in order, so both overloads
+        // give the same digest whatever the worker count
+        void hash_state(hash::state_hasher & hasher) const {
+            for(std::size_t chunk = 0; chunk < get_body_chunk_count(); ++chunk) {
+                hasher.update_value(hash_body_chunk(chunk));
+            }
+            hash_components(hasher);
+        }
+
+        void hash_state(hash::state_hasher & hasher, thread::job_pool & pool) const {
+            auto digests = std::vector<std::uint64_t>(get_body_chunk_count());
+            pool.parallel_for(0, static_cast<std::ptrdiff_t>(digests.size()), 1, [this, &digests] (std::ptrdiff_t begin, std::ptrdiff_t end) {
+                for(auto chunk = begin; chunk < end; ++chunk) {
+                    digests[chunk] = hash_body_chunk(static_cast<std::size_t>(chunk));
+                }
+            });
+            hasher.update(range::contiguous_view<std::uint64_t const>(digests));
+            hash_components(hasher);
+        }
+
+        // Flags bodies [begin, end) as changed since the last hash_changed_state
+        void mark_bodies_changed(std::size_t begin, std::size_t end) {
+            if(begin >= end) {
+                return;
+            }
+            changed_chunks.resize(std::max(changed_chunks.size(), get_body_chunk_count()));
+            for(auto chunk = begin / body_hash_chunk_size; chunk <= (end - 1) / body_hash_chunk_size; ++chunk) {
+                changed_chunks[chunk] = 1;
+            }
+        }
+
+        // Gives the same digest as hash_state, but only rehashes the body chunks flagged by mark_bodies_changed, and those
+        // holding bodies added since the last call, reusing the cached digests of the others. Bodies changed without
+        // being flagged, such as sleeping bodies moved by hand, are missed until their chunk is flagged again
+        void hash_changed_state(hash::state_hasher & hasher, thread::job_pool & pool) {
+            auto const body_count = table.get_bodies().size();
+            mark_bodies_changed(hashed_body_count, body_count);
+            hashed_body_count = body_count;
+            body_chunk_digests.resize(get_body_chunk_count());
+            changed_chunks.resize(body_chunk_digests.size());
+
+            chunks_to_hash.clear();
+            for(std::size_t chunk = 0; chunk < changed_chunks.size(); ++chunk) {
+                if(changed_chunks[chunk]) {
+                    chunks_to_hash.push_back(chunk);
+                    changed_chunks[chunk] = 0;
+                }
+            }
+            pool.parallel_for(0, static_cast<std::ptrdiff_t>(chunks_to_hash.size()), 1, [this] (std::ptrdiff_t begin, std::ptrdiff_t end) {
+                for(auto i = begin; i < end; ++i) {
+                    body_chunk_digests[chunks_to_hash[i]] = hash_body_chunk(chunks_to_hash[i]);
+                }
+            });
+            hasher.update(range::contiguous_view<std::uint64_t const>(body_chunk_digests));
+            hash_components(hasher);
+        }
+
         auto get_entities() noexcept -> range::contiguous_view<entity> {
-            return entities;
+            return table.get_entities();
         }
         auto get_entities() const noexcept -> range::contiguous_view<entity const> {
-            return entities;
+            return table.get_entities();
+        }
+
+        auto get_bodies() noexcept -> physics::body_storage2d & {
+            return table.get_bodies();
+        }
+        auto get_bodies() const noexcept -> physics::body_storage2d const& {
+            return table.get_bodies();
+        }
+
+        auto get_archetypes() const noexcept -> range::contiguous_view<archetype const> {
+            return archetypes;
         }
 
     private:
-        std::vector<entity> entities;
+        static constexpr std::size_t body_hash_chunk_size = 4096;
+
+        auto get_body_chunk_count() const noexcept -> std::size_t {
+            return (table.get_bodies().size() + body_hash_chunk_size - 1) / body_hash_chunk_size;
+        }
+
+        auto hash_body_chunk(std::size_t chunk) const noexcept -> std::uint64_t {
+            auto const& bodies = table.get_bodies();
+            auto const begin = static_cast<std::ptrdiff_t>(chunk * body_hash_chunk_size);
+            auto const count = std::min(static_cast<std::ptrdiff_t>(bodies.size()) - begin, static_cast<std::ptrdiff_t>(body_hash_chunk_size));
+            auto hasher = hash::state_hasher(chunk);
+            hasher.update(bodies.get_positions().subspan(begin, count));
+            hasher.update(bodies.get_velocities().subspan(begin, count));
+            hasher.update(bodies.get_awake().subspan(begin, count));
+            return hasher.digest();
+        }
+
+        void hash_components(hash::state_hasher & hasher) const {
+            for(auto const& archetype : archetypes) {
+                archetype.hash_state(hasher);
+            }
+        }
+
+        auto get_archetype(range::contiguous_view<entity_component const> components) -> archetype & {
+            auto signature = make_signature(components);
+            auto const it = std::find_if(archetypes.begin(), archetypes.end(), [&signature] (auto const& a) { return a.get_signature() == signature; });
+            if(it != archetypes.end()) {
+                return *it;
+            }
+            return archetypes.emplace_back(std::move(signature), components);
+        }
+
+        entity_table table;
+        // Cache of hash_changed_state
+        std::vector<std::uint64_t> body_chunk_digests;
+        std::vector<std::uint8_t> changed_chunks;
+        std::vector<std::size_t> chunks_to_hash;
+        std::size_t hashed_body_count = 0;
+        std::vector<archetype> archetypes;
         std::vector<world_component> components;
     };
-}
\ No newline at end of file
+}
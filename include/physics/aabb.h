@@ -0,0 +1,79 @@
+#pragma once
+
+#include <algorithm>
+#include <optional>
+#include <utility>
+
+#include "math/vector.h"
+#include "physics/body.h"
+
+namespace hz::physics {
+    // Axis-aligned bounding box
+    struct aabb2d {
+        vector2d min;
+        vector2d max;
+
+        constexpr auto overlaps(aabb2d const& other) const noexcept -> bool {
+            return min.x <= other.max.x && other.min.x <= max.x
+                && min.y <= other.max.y && other.min.y <= max.y;
+        }
+        constexpr auto contains(vector2d point) const noexcept -> bool {
+            return min.x <= point.x && point.x <= max.x
+                && min.y <= point.y && point.y <= max.y;
+        }
+        constexpr auto contains(aabb2d const& other) const noexcept -> bool {
+            return min.x <= other.min.x && other.max.x <= max.x
+                && min.y <= other.min.y && other.max.y <= max.y;
+        }
+
+        constexpr auto get_center() const noexcept -> vector2d {
+            return (min + max) / 2.0;
+        }
+        constexpr auto get_extent() const noexcept -> vector2d {
+            return max - min;
+        }
+        constexpr auto get_perimeter() const noexcept -> double {
+            return 2.0 * ((max.x - min.x) + (max.y - min.y));
+        }
+
+        constexpr auto fattened(double margin) const noexcept -> aabb2d {
+            return aabb2d{min - vector2d{margin, margin}, max + vector2d{margin, margin}};
+        }
+    };
+
+    constexpr auto merge(aabb2d const& lhs, aabb2d const& rhs) noexcept -> aabb2d {
+        return aabb2d{
+            vector2d{std::min(lhs.min.x, rhs.min.x), std::min(lhs.min.y, rhs.min.y)},
+            vector2d{std::max(lhs.max.x, rhs.max.x), std::max(lhs.max.y, rhs.max.y)},
+        };
+    }
+
+    // Fraction in [0, 1] of the segment from + t * delta where it enters the box, or nothing if it misses.
+    // A segment starting inside the box enters at 0
+    inline auto intersect_segment(aabb2d const& box, vector2d from, vector2d delta) noexcept -> std::optional<double> {
+        auto t_min = 0.0;
+        auto t_max = 1.0;
+        auto const slab = [&t_min, &t_max] (double origin, double direction, double min, double max) {
+            if(direction == 0.0) {
+                return min <= origin && origin <= max;
+            }
+            auto t1 = (min - origin) / direction;
+            auto t2 = (max - origin) / direction;
+            if(t1 > t2) {
+                std::swap(t1, t2);
+            }
+            t_min = std::max(t_min, t1);
+            t_max = std::min(t_max, t2);
+            return t_min <= t_max;
+        };
+        if(!slab(from.x, delta.x, box.min.x, box.max.x) || !slab(from.y, delta.y, box.min.y, box.max.y)) {
+            return std::nullopt;
+        }
+        return t_min;
+    }
+
+    // Bodies are centered on their position and span their dimension
+    constexpr auto make_aabb(position2d position, vector2d dimension) noexcept -> aabb2d {
+        return aabb2d{position.value - dimension / 2.0, position.value + dimension / 2.0};
+    }
+}
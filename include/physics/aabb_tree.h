@@ -0,0 +1,354 @@
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include <gsl/gsl_assert>
+
+#include "common/range/view.h"
+#include "physics/aabb.h"
+
+namespace hz::physics {
+    struct ray_hit {
+        std::uint32_t user;
+        double fraction;
+    };
+
+    // Dynamic bounding volume hierarchy over fattened boxes. Leaves keep their tight box for exact query results, and are only
+    // reinserted when the tight box leaves the fat one. Inner nodes are kept balanced with AVL-style rotations.
+    // Queries write into caller buffers and return the total number of results, which can be larger than the buffer
+    class aabb_tree {
+    public:
+        using proxy_id = std::int32_t;
+        static constexpr proxy_id null_node = -1;
+
+        explicit aabb_tree(double margin = 0.1) noexcept
+            : margin(margin) {
+
+        }
+
+        auto insert(aabb2d const& box, std::uint32_t user) -> proxy_id {
+            auto const leaf = allocate_node();
+            auto & n = nodes[leaf];
+            n.box = box;
+            n.fat = box.fattened(margin);
+            n.user = user;
+            n.height = 0;
+            insert_leaf(leaf);
+            return leaf;
+        }
+
+        void remove(proxy_id proxy) {
+            remove_leaf(proxy);
+            free_node(proxy);
+        }
+
+        // Returns whether the proxy had to be reinserted
+        auto move(proxy_id proxy, aabb2d const& box) -> bool {
+            nodes[proxy].box = box;
+            if(nodes[proxy].fat.contains(box)) {
+                return false;
+            }
+            remove_leaf(proxy);
+            nodes[proxy].fat = box.fattened(margin);
+            insert_leaf(proxy);
+            return true;
+        }
+
+        auto get_user(proxy_id proxy) const noexcept -> std::uint32_t {
+            return nodes[proxy].user;
+        }
+        auto get_fat_box(proxy_id proxy) const noexcept -> aabb2d const& {
+            return nodes[proxy].fat;
+        }
+        auto get_height() const noexcept -> std::int32_t {
+            return root == null_node ? 0 : nodes[root].height;
+        }
+
+        auto query(vector2d point, range::contiguous_view<std::uint32_t> out) const -> std::size_t {
+            return traverse([point] (aabb2d const& fat) { return fat.contains(point); },
+                [point, out] (node const& leaf, std::size_t count) {
+                    if(!leaf.box.contains(point)) {
+                        return false;
+                    }
+                    if(count < static_cast<std::size_t>(out.size())) {
+                        out[count] = leaf.user;
+                    }
+                    return true;
+                });
+        }
+
+        auto query(aabb2d const& box, range::contiguous_view<std::uint32_t> out) const -> std::size_t {
+            return traverse([&box] (aabb2d const& fat) { return fat.overlaps(box); },
+                [&box, out] (node const& leaf, std::size_t count) {
+                    if(!leaf.box.overlaps(box)) {
+                        return false;
+                    }
+                    if(count < static_cast<std::size_t>(out.size())) {
+                        out[count] = leaf.user;
+                    }
+                    return true;
+                });
+        }
+
+        // Every box crossed by the segment from-to, in no particular order
+        auto raycast(vector2d from, vector2d to, range::contiguous_view<ray_hit> out) const -> std::size_t {
+            auto const delta = to - from;
+            return traverse([from, delta] (aabb2d const& fat) { return intersect_segment(fat, from, delta).has_value(); },
+                [from, delta, out] (node const& leaf, std::size_t count) {
+                    auto const fraction = intersect_segment(leaf.box, from, delta);
+                    if(!fraction) {
+                        return false;
+                    }
+                    if(count < static_cast<std::size_t>(out.size())) {
+                        out[count] = ray_hit{leaf.user, *fraction};
+                    }
+                    return true;
+                });
+        }
+
+    private:
+        struct node {
+            aabb2d fat;
+            aabb2d box;
+            // Parent while in the tree, next free node while in the free list
+            proxy_id parent = null_node;
+            proxy_id child1 = null_node;
+            proxy_id child2 = null_node;
+            std::int32_t height = -1;
+            std::uint32_t user = 0;
+
+            auto is_leaf() const noexcept -> bool {
+                return child1 == null_node;
+            }
+        };
+
+        template<typename EnterF, typename LeafF>
+        auto traverse(EnterF && enter, LeafF && visit_leaf) const -> std::size_t {
+            // A balanced tree of a billion leaves is well under 64 levels deep
+            auto stack = std::array<proxy_id, 128>();
+            auto stack_size = std::size_t(0);
+            auto count = std::size_t(0);
+            if(root != null_node) {
+                stack[stack_size++] = root;
+            }
+            while(stack_size > 0) {
+                auto const& n = nodes[stack[--stack_size]];
+                if(!enter(n.fat)) {
+                    continue;
+                }
+                if(n.is_leaf()) {
+                    if(visit_leaf(n, count)) {
+                        ++count;
+                    }
+                } else {
+                    Expects(stack_size + 2 <= stack.size());
+                    stack[stack_size++] = n.child1;
+                    stack[stack_size++] = n.child2;
+                }
+            }
+            return count;
+        }
+
+        auto allocate_node() -> proxy_id {
+            if(free_list == null_node) {
+                nodes.emplace_back();
+                return static_cast<proxy_id>(nodes.size() - 1);
+            }
+            auto const index = free_list;
+            free_list = nodes[index].parent;
+            nodes[index] = node();
+            return index;
+        }
+
+        void free_node(proxy_id index) noexcept {
+            nodes[index].parent = free_list;
+            nodes[index].height = -1;
+            free_list = index;
+        }
+
+        void insert_leaf(proxy_id leaf) {
+            if(root == null_node) {
+                root = leaf;
+                nodes[leaf].parent = null_node;
+                return;
+            }
+
+            // Walk down towards the sibling with the lowest increase in total perimeter
+            auto const leaf_box = nodes[leaf].fat;
+            auto index = root;
+            while(!nodes[index].is_leaf()) {
+                auto const& n = nodes[index];
+                auto const area = n.fat.get_perimeter();
+                auto const combined_area = merge(n.fat, leaf_box).get_perimeter();
+                auto const cost = 2.0 * combined_area;
+                auto const inheritance_cost = 2.0 * (combined_area - area);
+
+                auto const descend_cost = [&] (proxy_id child) {
+                    auto const& c = nodes[child];
+                    auto const merged = merge(leaf_box, c.fat).get_perimeter();
+                    return (c.is_leaf() ? merged : merged - c.fat.get_perimeter()) + inheritance_cost;
+                };
+                auto const cost1 = descend_cost(n.child1);
+                auto const cost2 = descend_cost(n.child2);
+                if(cost < cost1 && cost < cost2) {
+                    break;
+                }
+                index = cost1 < cost2 ? n.child1 : n.child2;
+            }
+
+            auto const sibling = index;
+            auto const old_parent = nodes[sibling].parent;
+            auto const new_parent = allocate_node();
+            nodes[new_parent].parent = old_parent;
+            nodes[new_parent].fat = merge(leaf_box, nodes[sibling].fat);
+            nodes[new_parent].height = nodes[sibling].height + 1;
+            nodes[new_parent].child1 = sibling;
+            nodes[new_parent].child2 = leaf;
+            nodes[sibling].parent = new_parent;
+            nodes[leaf].parent = new_parent;
+
+            if(old_parent != null_node) {
+                replace_child(old_parent, sibling, new_parent);
+            } else {
+                root = new_parent;
+            }
+
+            refit_from(nodes[leaf].parent);
+        }
+
+        void remove_leaf(proxy_id leaf) {
+            if(leaf == root) {
+                root = null_node;
+                return;
+            }
+
+            auto const parent = nodes[leaf].parent;
+            auto const grand_parent = nodes[parent].parent;
+            auto const sibling = nodes[parent].child1 == leaf ? nodes[parent].child2 : nodes[parent].child1;
+
+            if(grand_parent != null_node) {
+                replace_child(grand_parent, parent, sibling);
+                nodes[sibling].parent = grand_parent;
+                free_node(parent);
+                refit_from(grand_parent);
+            } else {
+                root = sibling;
+                nodes[sibling].parent = null_node;
+                free_node(parent);
+            }
+        }
+
+        void replace_child(proxy_id parent, proxy_id old_child, proxy_id new_child) noexcept {
+            if(nodes[parent].child1 == old_child) {
+                nodes[parent].child1 = new_child;
+            } else {
+                nodes[parent].child2 = new_child;
+            }
+        }
+
+        void refit_from(proxy_id index) noexcept {
+            while(index != null_node) {
+                index = balance(index);
+                auto & n = nodes[index];
+                n.height = 1 + std::max(nodes[n.child1].height, nodes[n.child2].height);
+                n.fat = merge(nodes[n.child1].fat, nodes[n.child2].fat);
+                index = n.parent;
+            }
+        }
+
+        // Rotates the taller grandchild up when a's children differ in height by more than one. Returns the new subtree root
+        auto balance(proxy_id ia) noexcept -> proxy_id {
+            auto & a = nodes[ia];
+            if(a.is_leaf() || a.height < 2) {
+                return ia;
+            }
+
+            auto const ib = a.child1;
+            auto const ic = a.child2;
+            auto & b = nodes[ib];
+            auto & c = nodes[ic];
+            auto const difference = c.height - b.height;
+
+            if(difference > 1) {
+                auto const i_f = c.child1;
+                auto const ig = c.child2;
+                auto & f = nodes[i_f];
+                auto & g = nodes[ig];
+
+                c.child1 = ia;
+                c.parent = a.parent;
+                a.parent = ic;
+                if(c.parent != null_node) {
+                    replace_child(c.parent, ia, ic);
+                } else {
+                    root = ic;
+                }
+
+                if(f.height > g.height) {
+                    c.child2 = i_f;
+                    a.child2 = ig;
+                    g.parent = ia;
+                    a.fat = merge(b.fat, g.fat);
+                    c.fat = merge(a.fat, f.fat);
+                    a.height = 1 + std::max(b.height, g.height);
+                    c.height = 1 + std::max(a.height, f.height);
+                } else {
+                    c.child2 = ig;
+                    a.child2 = i_f;
+                    f.parent = ia;
+                    a.fat = merge(b.fat, f.fat);
+                    c.fat = merge(a.fat, g.fat);
+                    a.height = 1 + std::max(b.height, f.height);
+                    c.height = 1 + std::max(a.height, g.height);
+                }
+                return ic;
+            }
+
+            if(difference < -1) {
+                auto const id = b.child1;
+                auto const ie = b.child2;
+                auto & d = nodes[id];
+                auto & e = nodes[ie];
+
+                b.child1 = ia;
+                b.parent = a.parent;
+                a.parent = ib;
+                if(b.parent != null_node) {
+                    replace_child(b.parent, ia, ib);
+                } else {
+                    root = ib;
+                }
+
+                if(d.height > e.height) {
+                    b.child2 = id;
+                    a.child1 = ie;
+                    e.parent = ia;
+                    a.fat = merge(c.fat, e.fat);
+                    b.fat = merge(a.fat, d.fat);
+                    a.height = 1 + std::max(c.height, e.height);
+                    b.height = 1 + std::max(a.height, d.height);
+                } else {
+                    b.child2 = ie;
+                    a.child1 = id;
+                    d.parent = ia;
+                    a.fat = merge(c.fat, d.fat);
+                    b.fat = merge(a.fat, e.fat);
+                    a.height = 1 + std::max(c.height, d.height);
+                    b.height = 1 + std::max(a.height, e.height);
+                }
+                return ib;
+            }
+
+            return ia;
+        }
+
+        double margin;
+        std::vector<node> nodes;
+        proxy_id root = null_node;
+        proxy_id free_list = null_node;
+    };
+}
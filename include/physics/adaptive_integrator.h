@@ -0,0 +1,77 @@
+#pragma once
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <vector>
+
+#include <gsl/gsl_assert>
+
+#include "math/integration.h"
+#include "physics/body_storage.h"
+
+namespace hz::physics {
+    struct adaptive_tolerance {
+        double absolute = 1e-6;
+        double relative = 1e-9;
+    };
+
+    // Sub-steps each body through the tick with Dormand-Prince steps, under its accumulated acceleration plus the field
+    // f(position2d, velocity2d) -> acceleration2d. Step sizes are kept per body between ticks, so bodies in gentle fields
+    // take a single step per tick and only the ones in stiff or fast changing fields pay for more
+    class adaptive_integrator {
+    public:
+        explicit adaptive_integrator(adaptive_tolerance tolerance = {}, math::adaptive_settings settings = {}) noexcept
+            : tolerance(tolerance)
+            , settings(settings) {
+
+        }
+
+        // Starts bodies added since the last call with a full tick step. Call before integrating ranges from several threads
+        void track(body_storage2d const& bodies, seconds dt) {
+            steps.resize(bodies.size(), dt.count());
+        }
+
+        template<typename F>
+        void integrate(body_storage2d & bodies, F && field, seconds dt) {
+            track(bodies, dt);
+            integrate(bodies, field, dt, 0, bodies.size());
+        }
+
+        // Only touches bodies in [begin, end), so disjoint ranges can run in parallel
+        template<typename F>
+        void integrate(body_storage2d & bodies, F && field, seconds dt, std::size_t begin, std::size_t end) {
+            Expects(end <= steps.size() && end <= bodies.size());
+            auto const positions = bodies.get_positions();
+            auto const velocities = bodies.get_velocities();
+            auto const accelerations = std::as_const(bodies).get_accelerations();
+            auto const norm = [this] (vector2d x_error, vector2d v_error, vector2d x, vector2d v) {
+                auto const scaled = [this] (double error, double value) {
+                    return std::abs(error) / (tolerance.absolute + tolerance.relative * std::abs(value));
+                };
+                return std::max({scaled(x_error.x, x.x), scaled(x_error.y, x.y), scaled(v_error.x, v.x), scaled(v_error.y, v.y)});
+            };
+
+            for(auto i = begin; i < end; ++i) {
+                auto const accumulated = accelerations[i].value;
+                auto const a = [&field, accumulated] (double, vector2d x, vector2d v) {
+                    return accumulated + field(position2d(x), velocity2d(v)).value;
+                };
+                auto const result = math::integrate_adaptive(positions[i].value, velocities[i].value, a, 0.0, dt.count(), std::min(steps[i], dt.count()), norm, settings);
+                positions[i].value = result.x;
+                velocities[i].value = result.v;
+                steps[i] = result.step;
+            }
+        }
+
+        // Step size the body will start its next tick with, before capping it to the tick length
+        auto get_step(std::size_t body) const noexcept -> seconds {
+            return seconds(steps[body]);
+        }
+
+    private:
+        adaptive_tolerance tolerance;
+        math::adaptive_settings settings;
+        std::vector<double> steps;
+    };
+}
@@ -1,5 +1,7 @@
 #pragma once
 
+#include <tuple>
+
 #include "math/vector.h"
 #include "math/integration.h"
 #include "time.h"
@@ -9,117 +11,172 @@
 namespace hz::physics {
     using math::vector2d;
 
-    struct displacement2d {
-        displacement2d() = default;
-        constexpr explicit displacement2d(double x, double y) noexcept : value{ x, y } { }
-        constexpr explicit displacement2d(vector2d value) noexcept : value(value) { }
+    // Physics quantities are templated on their scalar type: double by default, float to halve body memory and double
+    // the SIMD lane width in batch loops
+    template<typename T>
+    struct basic_displacement2d {
+        using vector_type = math::basic_vector2d<T>;
+
+        basic_displacement2d() = default;
+        constexpr explicit basic_displacement2d(T x, T y) noexcept : value{ x, y } { }
+        constexpr explicit basic_displacement2d(vector_type value) noexcept : value(value) { }
 
-        vector2d value;
+        vector_type value;
     };
 
-    struct position2d {
-        position2d() = default;
-        constexpr explicit position2d(double x, double y) noexcept : value{ x,y } { }
-        constexpr explicit position2d(vector2d value) noexcept : value(value) { }
+    template<typename T>
+    struct basic_position2d {
+        using vector_type = math::basic_vector2d<T>;
 
-        constexpr auto operator+(displacement2d other) const noexcept -> position2d {
-            return position2d(value + other.value);
+        basic_position2d() = default;
+        constexpr explicit basic_position2d(T x, T y) noexcept : value{ x,y } { }
+        constexpr explicit basic_position2d(vector_type value) noexcept : value(value) { }
+
+        constexpr auto operator+(basic_displacement2d<T> other) const noexcept -> basic_position2d {
+            return basic_position2d(value + other.value);
         }
-        constexpr auto operator+=(displacement2d other) noexcept -> position2d & {
+        constexpr auto operator+=(basic_displacement2d<T> other) noexcept -> basic_position2d & {
             value += other.value;
             return *this;
         }
-        constexpr auto operator-(position2d other) const noexcept -> displacement2d {
-            return displacement2d(value - other.value);
+        constexpr auto operator-(basic_position2d other) const noexcept -> basic_displacement2d<T> {
+            return basic_displacement2d<T>(value - other.value);
         }
 
 
-        vector2d value;
+        vector_type value;
     };
 
-    struct velocity2d {
-        velocity2d() = default;
-        constexpr explicit velocity2d(double x, double y) noexcept : value{ x,y } { }
-        constexpr explicit velocity2d(vector2d value) noexcept : value(value) { }
+    template<typename T>
+    struct basic_velocity2d {
+        using vector_type = math::basic_vector2d<T>;
+
+        basic_velocity2d() = default;
+        constexpr explicit basic_velocity2d(T x, T y) noexcept : value{ x,y } { }
+        constexpr explicit basic_velocity2d(vector_type value) noexcept : value(value) { }
 
-        constexpr auto operator+(velocity2d other) const noexcept -> velocity2d {
-            return velocity2d(value + other.value);
+        constexpr auto operator+(basic_velocity2d other) const noexcept -> basic_velocity2d {
+            return basic_velocity2d(value + other.value);
         }
-        constexpr auto operator+=(velocity2d other) noexcept -> velocity2d & {
+        constexpr auto operator+=(basic_velocity2d other) noexcept -> basic_velocity2d & {
             value += other.value;
             return *this;
         }
-        constexpr auto operator*(seconds t) const noexcept -> displacement2d {
-            return displacement2d(value * t.count());
+        constexpr auto operator*(seconds t) const noexcept -> basic_displacement2d<T> {
+            return basic_displacement2d<T>(value * static_cast<T>(t.count()));
         }
 
-        vector2d value;
+        vector_type value;
     };
 
-    struct acceleration2d {
-        acceleration2d() = default;
-        constexpr explicit acceleration2d(double x, double y) noexcept : value{ x,y } { }
-        constexpr explicit acceleration2d(vector2d value) noexcept : value(value) { }
+    template<typename T>
+    struct basic_acceleration2d {
+        using vector_type = math::basic_vector2d<T>;
 
-        constexpr auto operator+(acceleration2d other) const noexcept -> acceleration2d {
-            return acceleration2d(value + other.value);
+        basic_acceleration2d() = default;
+        constexpr explicit basic_acceleration2d(T x, T y) noexcept : value{ x,y } { }
+        constexpr explicit basic_acceleration2d(vector_type value) noexcept : value(value) { }
+
+        constexpr auto operator+(basic_acceleration2d other) const noexcept -> basic_acceleration2d {
+            return basic_acceleration2d(value + other.value);
         }
-        constexpr auto operator+=(acceleration2d other) noexcept -> acceleration2d & {
+        constexpr auto operator+=(basic_acceleration2d other) noexcept -> basic_acceleration2d & {
             value += other.value;
             return *this;
         }
-        constexpr auto operator*(seconds t) const noexcept -> velocity2d {
-            return velocity2d(value * t.count());
+        constexpr auto operator*(seconds t) const noexcept -> basic_velocity2d<T> {
+            return basic_velocity2d<T>(value * static_cast<T>(t.count()));
         }
 
-        vector2d value;
+        vector_type value;
     };
 
-    struct weight {
-        double value;
+    template<typename T>
+    struct basic_weight {
+        T value;
     };
 
-    struct force2d {
-        force2d() = default;
-        constexpr force2d(double x, double y) noexcept : value{ x,y } { }
-        constexpr explicit force2d(vector2d value) noexcept : value(value) { }
+    template<typename T>
+    struct basic_force2d {
+        using vector_type = math::basic_vector2d<T>;
+
+        basic_force2d() = default;
+        constexpr basic_force2d(T x, T y) noexcept : value{ x,y } { }
+        constexpr explicit basic_force2d(vector_type value) noexcept : value(value) { }
             
-        constexpr auto operator+(force2d other) const noexcept -> force2d {
-            return force2d(value + other.value);
+        constexpr auto operator+(basic_force2d other) const noexcept -> basic_force2d {
+            return basic_force2d(value + other.value);
         }
-        constexpr auto operator+=(force2d other) noexcept -> force2d & {
+        constexpr auto operator+=(basic_force2d other) noexcept -> basic_force2d & {
             value += other.value;
             return *this;
         }
-        constexpr auto operator/(weight w) const noexcept -> acceleration2d {
-            return acceleration2d(value / w.value);
+        constexpr auto operator/(basic_weight<T> w) const noexcept -> basic_acceleration2d<T> {
+            return basic_acceleration2d<T>(value / w.value);
         }
 
-        vector2d value;
+        vector_type value;
+    };
+
+    using displacement2d = basic_displacement2d<double>;
+    using position2d = basic_position2d<double>;
+    using velocity2d = basic_velocity2d<double>;
+    using acceleration2d = basic_acceleration2d<double>;
+    using weight = basic_weight<double>;
+    using force2d = basic_force2d<double>;
+
+    // An infinite weight makes a body static: forces and contacts no longer move it
+    template<typename T>
+    constexpr auto get_inverse_mass(basic_weight<T> w) noexcept -> T {
+        return T(1) / w.value;
+    }
+
+    struct surface_material {
+        double restitution = 0.0;
+        double friction = 0.5;
     };
 
-    struct body2d {
-        position2d position = {};
-        velocity2d velocity = {};
-        acceleration2d acceleration = {};
-        vector2d dimension = { 1.0, 1.0 };
-        weight weight = { 1.0 };
+    template<typename T>
+    struct basic_body2d {
+        basic_position2d<T> position = {};
+        basic_velocity2d<T> velocity = {};
+        basic_acceleration2d<T> acceleration = {};
+        math::basic_vector2d<T> dimension = { T(1), T(1) };
+        basic_weight<T> weight = { T(1) };
+        surface_material material = {};
 
-        auto add_force(force2d f) -> body2d & {
+        auto add_force(basic_force2d<T> f) -> basic_body2d & {
             acceleration += f / weight;
             return *this;
         }
     };
 
+    using body2d = basic_body2d<double>;
+    using body2f = basic_body2d<float>;
+
     template<typename T, typename U> 
     constexpr auto rk1(T t, U u, seconds dt) {
         return math::rk1(t, functional::make_identity(u), 0, dt);
     }
 
-    constexpr auto integrate(body2d b, seconds dt) -> body2d {
+    template<typename T>
+    constexpr auto integrate(basic_body2d<T> b, seconds dt) -> basic_body2d<T> {
         b.velocity = rk1(b.velocity, b.acceleration, dt / 2);
         b.position = rk1(b.position, b.velocity, dt);
         b.velocity = rk1(b.velocity, b.acceleration, dt / 2);
         return b;
     }
+
+    // Integrates b with a math integrator policy, under its accumulated acceleration plus the acceleration field
+    // f(position, velocity) -> acceleration, for forces that change within the step such as springs or orbits
+    template<typename Integrator, typename T, typename F>
+    constexpr auto integrate(basic_body2d<T> b, F && field, seconds dt) -> basic_body2d<T> {
+        using vector_type = math::basic_vector2d<T>;
+        auto const accumulated = b.acceleration.value;
+        auto const a = [&field, accumulated] (T, vector_type x, vector_type v) {
+            return accumulated + field(basic_position2d<T>(x), basic_velocity2d<T>(v)).value;
+        };
+        std::tie(b.position.value, b.velocity.value) = Integrator::step(b.position.value, b.velocity.value, a, T(0), static_cast<T>(dt.count()));
+        return b;
+    }
 }
@@ -0,0 +1,253 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+#include "common/range/view.h"
+#include "physics/body.h"
+#include "physics/integrate_batch.h"
+
+namespace hz::physics {
+    class body_storage2d;
+
+    // Reference to one body in a body_storage2d. Stays valid as long as the storage is neither moved nor copied over
+    class body2d_ref {
+    public:
+        body2d_ref() = default;
+        body2d_ref(body_storage2d & storage, std::size_t index) noexcept
+            : storage(&storage)
+            , index(index) {
+
+        }
+
+        auto position() const noexcept -> position2d &;
+        auto velocity() const noexcept -> velocity2d &;
+        auto acceleration() const noexcept -> acceleration2d &;
+        auto dimension() const noexcept -> vector2d &;
+        auto weight() const noexcept -> physics::weight &;
+        auto material() const noexcept -> surface_material &;
+
+        // Forces on a sleeping body are dropped, so that constant forces like gravity do not pile up while it sleeps
+        auto add_force(force2d f) const noexcept -> body2d_ref const& {
+            if(is_awake()) {
+                acceleration() += f / weight();
+            }
+            return *this;
+        }
+        // For forces proportional to the weight, like gravity, which would divide infinity by infinity on static bodies.
+        // Static bodies take no acceleration
+        auto add_acceleration(acceleration2d a) const noexcept -> body2d_ref const& {
+            if(is_awake() && get_inverse_mass(weight()) > 0.0) {
+                acceleration() += a;
+            }
+            return *this;
+        }
+
+        auto is_awake() const noexcept -> bool;
+        // Asks the sleep system to wake the body's island on its next pass. The body takes forces again right away.
+        // Safe to call from parallel component updates, as long as each body is only woken through its own entity
+        void wake() const noexcept;
+
+        auto load() const noexcept -> body2d;
+        void store(body2d const& b) const noexcept;
+
+        auto get_index() const noexcept -> std::size_t {
+            return index;
+        }
+
+    private:
+        body_storage2d * storage = nullptr;
+        std::size_t index = 0;
+    };
+
+    // Indices of bodies woken since the list was last cleared. A body is only pushed as it goes from asleep to awake, so
+    // it is pushed at most once between clears, and the list never needs more room than there are bodies. Pushes from
+    // several threads only share the counter
+    class wake_list {
+    public:
+        wake_list() = default;
+        wake_list(wake_list const& other)
+            : indices(other.indices)
+            , count(other.count.load(std::memory_order_relaxed)) {
+
+        }
+        auto operator=(wake_list const& other) -> wake_list & {
+            indices = other.indices;
+            count.store(other.count.load(std::memory_order_relaxed), std::memory_order_relaxed);
+            return *this;
+        }
+
+        void resize(std::size_t body_count) {
+            indices.resize(body_count);
+        }
+        void reserve(std::size_t body_count) {
+            indices.reserve(body_count);
+        }
+
+        void push(std::uint32_t body) noexcept {
+            indices[count.fetch_add(1, std::memory_order_relaxed)] = body;
+        }
+
+        auto get() const noexcept -> range::contiguous_view<std::uint32_t const> {
+            return range::contiguous_view<std::uint32_t const>(indices).subspan(0, count.load(std::memory_order_relaxed));
+        }
+
+        void clear() noexcept {
+            count.store(0, std::memory_order_relaxed);
+        }
+
+    private:
+        std::vector<std::uint32_t> indices;
+        std::atomic<std::size_t> count = 0;
+    };
+
+    // Struct-of-arrays storage for body2d: each field lives in its own contiguous column
+    class body_storage2d {
+    public:
+        auto push_back(body2d const& b) -> std::size_t {
+            positions.push_back(b.position);
+            velocities.push_back(b.velocity);
+            accelerations.push_back(b.acceleration);
+            dimensions.push_back(b.dimension);
+            weights.push_back(b.weight);
+            materials.push_back(b.material);
+            awake.push_back(get_inverse_mass(b.weight) > 0.0);
+            woken.resize(awake.size());
+            return positions.size() - 1;
+        }
+
+        void reserve(std::size_t n) {
+            positions.reserve(n);
+            velocities.reserve(n);
+            accelerations.reserve(n);
+            dimensions.reserve(n);
+            weights.reserve(n);
+            materials.reserve(n);
+            awake.reserve(n);
+            woken.reserve(n);
+        }
+
+        auto size() const noexcept -> std::size_t {
+            return positions.size();
+        }
+
+        auto operator[](std::size_t i) noexcept -> body2d_ref {
+            return body2d_ref(*this, i);
+        }
+
+        auto load(std::size_t i) const noexcept -> body2d {
+            return body2d{positions[i], velocities[i], accelerations[i], dimensions[i], weights[i], materials[i]};
+        }
+        void store(std::size_t i, body2d const& b) noexcept {
+            positions[i] = b.position;
+            velocities[i] = b.velocity;
+            accelerations[i] = b.acceleration;
+            dimensions[i] = b.dimension;
+            weights[i] = b.weight;
+            materials[i] = b.material;
+        }
+
+        auto get_positions() noexcept -> range::contiguous_view<position2d> {
+            return positions;
+        }
+        auto get_positions() const noexcept -> range::contiguous_view<position2d const> {
+            return positions;
+        }
+        auto get_velocities() noexcept -> range::contiguous_view<velocity2d> {
+            return velocities;
+        }
+        auto get_velocities() const noexcept -> range::contiguous_view<velocity2d const> {
+            return velocities;
+        }
+        auto get_accelerations() noexcept -> range::contiguous_view<acceleration2d> {
+            return accelerations;
+        }
+        auto get_accelerations() const noexcept -> range::contiguous_view<acceleration2d const> {
+            return accelerations;
+        }
+        auto get_dimensions() noexcept -> range::contiguous_view<vector2d> {
+            return dimensions;
+        }
+        auto get_dimensions() const noexcept -> range::contiguous_view<vector2d const> {
+            return dimensions;
+        }
+        auto get_weights() noexcept -> range::contiguous_view<weight> {
+            return weights;
+        }
+        auto get_weights() const noexcept -> range::contiguous_view<weight const> {
+            return weights;
+        }
+        auto get_materials() noexcept -> range::contiguous_view<surface_material> {
+            return materials;
+        }
+        auto get_materials() const noexcept -> range::contiguous_view<surface_material const> {
+            return materials;
+        }
+        // Non-zero for bodies that are integrated and collide each tick. Static bodies start asleep
+        auto get_awake() noexcept -> range::contiguous_view<std::uint8_t> {
+            return awake;
+        }
+        auto get_awake() const noexcept -> range::contiguous_view<std::uint8_t const> {
+            return awake;
+        }
+        // Bodies woken through body2d_ref::wake, for the sleep system to drain
+        auto get_woken() noexcept -> wake_list & {
+            return woken;
+        }
+        auto get_woken() const noexcept -> wake_list const& {
+            return woken;
+        }
+
+    private:
+        std::vector<position2d> positions;
+        std::vector<velocity2d> velocities;
+        std::vector<acceleration2d> accelerations;
+        std::vector<vector2d> dimensions;
+        std::vector<weight> weights;
+        std::vector<surface_material> materials;
+        std::vector<std::uint8_t> awake;
+        wake_list woken;
+    };
+
+    inline auto body2d_ref::position() const noexcept -> position2d & {
+        return storage->get_positions()[index];
+    }
+    inline auto body2d_ref::velocity() const noexcept -> velocity2d & {
+        return storage->get_velocities()[index];
+    }
+    inline auto body2d_ref::acceleration() const noexcept -> acceleration2d & {
+        return storage->get_accelerations()[index];
+    }
+    inline auto body2d_ref::dimension() const noexcept -> vector2d & {
+        return storage->get_dimensions()[index];
+    }
+    inline auto body2d_ref::weight() const noexcept -> physics::weight & {
+        return storage->get_weights()[index];
+    }
+    inline auto body2d_ref::material() const noexcept -> surface_material & {
+        return storage->get_materials()[index];
+    }
+    inline auto body2d_ref::is_awake() const noexcept -> bool {
+        return storage->get_awake()[index] != 0;
+    }
+    inline void body2d_ref::wake() const noexcept {
+        auto & flag = storage->get_awake()[index];
+        if(!flag) {
+            flag = 1;
+            storage->get_woken().push(static_cast<std::uint32_t>(index));
+        }
+    }
+    inline auto body2d_ref::load() const noexcept -> body2d {
+        return storage->load(index);
+    }
+    inline void body2d_ref::store(body2d const& b) const noexcept {
+        storage->store(index, b);
+    }
+
+    inline void integrate(body_storage2d & bodies, seconds dt) noexcept {
+        integrate_batch(bodies.get_positions(), bodies.get_velocities(), std::as_const(bodies).get_accelerations(), dt);
+    }
+}
@@ -0,0 +1,315 @@
+#pragma once
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <unordered_map>
+#include <vector>
+
+#include <gsl/gsl_assert>
+
+#include "common/range/view.h"
+#include "physics/aabb.h"
+#include "physics/body.h"
+
+namespace hz::physics {
+    // Two bodies may collide when each one's layer is in the other's mask
+    struct collision_filter {
+        std::uint32_t layer = 0x1;
+        std::uint32_t mask = 0xFFFFFFFF;
+    };
+
+    constexpr auto can_collide(collision_filter lhs, collision_filter rhs) noexcept -> bool {
+        return (lhs.layer & rhs.mask) != 0 && (rhs.layer & lhs.mask) != 0;
+    }
+
+    // Candidate pair of overlapping proxies, with first < second
+    struct proxy_pair {
+        std::uint32_t first;
+        std::uint32_t second;
+
+        constexpr auto operator==(proxy_pair other) const noexcept -> bool {
+            return first == other.first && second == other.second;
+        }
+        constexpr auto operator<(proxy_pair other) const noexcept -> bool {
+            return first < other.first || (first == other.first && second < other.second);
+        }
+    };
+
+    // Uniform grid broad phase. Each proxy is filed in every cell its box touches, and only moves between cells when its
+    // covered cell range changes. Pairs are tested within cells, so the cost is linear in the number of proxies as long as
+    // the cell size is on the order of the typical box size. Boxes covering more than max_cells_per_proxy cells are kept
+    // out of the grid and tested against every proxy instead, and cell coordinates saturate far from the origin, where
+    // the outermost cells hold everything beyond them
+    class spatial_hash {
+    public:
+        static constexpr std::int64_t max_cells_per_proxy = 1024;
+
+        explicit spatial_hash(double cell_size) noexcept
+            : cell_size(cell_size) {
+            Expects(cell_size > 0.0);
+        }
+
+        auto get_cell_size() const noexcept -> double {
+            return cell_size;
+        }
+
+        auto size() const noexcept -> std::size_t {
+            return proxies.size();
+        }
+
+        // Proxies are numbered in insertion order
+        auto insert(aabb2d const& box, collision_filter filter = {}) -> std::uint32_t {
+            auto const index = static_cast<std::uint32_t>(proxies.size());
+            proxies.push_back(proxy{box, get_cell_range(box), filter});
+            add_to_cells(index);
+            return index;
+        }
+
+        void move(std::uint32_t index, aabb2d const& box) {
+            auto & p = proxies[index];
+            p.box = box;
+            auto const cells = get_cell_range(box);
+            if(cells != p.cells) {
+                remove_from_cells(index);
+                p.cells = cells;
+                add_to_cells(index);
+            }
+        }
+
+        void set_filter(std::uint32_t index, collision_filter filter) noexcept {
+            proxies[index].filter = filter;
+        }
+
+        // Inserts proxies for new bodies and moves the existing ones, so that proxy i tracks body i
+        void update(range::contiguous_view<position2d const> positions, range::contiguous_view<vector2d const> dimensions) {
+            Expects(positions.size() == dimensions.size());
+            auto const existing = std::min<std::ptrdiff_t>(positions.size(), proxies.size());
+            for(std::ptrdiff_t i = 0; i < existing; ++i) {
+                move(static_cast<std::uint32_t>(i), make_aabb(positions[i], dimensions[i]));
+            }
+            for(auto i = existing; i < positions.size(); ++i) {
+                insert(make_aabb(positions[i], dimensions[i]));
+            }
+        }
+
+        // Same as above, but only the active proxies are moved: sleeping and static bodies stay where they were filed, and
+        // cost nothing
+        void update(range::contiguous_view<position2d const> positions, range::contiguous_view<vector2d const> dimensions,
+                    range::contiguous_view<std::uint32_t const> active) {
+            Expects(positions.size() == dimensions.size());
+            auto const existing = static_cast<std::uint32_t>(std::min<std::size_t>(positions.size(), proxies.size()));
+            for(auto const i : active) {
+                if(i < existing) {
+                    move(i, make_aabb(positions[i], dimensions[i]));
+                }
+            }
+            for(auto i = std::ptrdiff_t(existing); i < positions.size(); ++i) {
+                insert(make_aabb(positions[i], dimensions[i]));
+            }
+        }
+
+        // Writes each overlapping, filter-compatible pair once into out, and returns the number of pairs found.
+        // When that number is larger than out, the extra pairs were dropped and the caller should retry with more room
+        auto find_pairs(range::contiguous_view<proxy_pair> out) const -> std::size_t {
+            auto count = std::size_t(0);
+            for(auto const& [key, members] : cells) {
+                auto const cell = unpack(key);
+                for(std::size_t i = 0; i < members.size(); ++i) {
+                    auto const& a = proxies[members[i]];
+                    for(auto j = i + 1; j < members.size(); ++j) {
+                        auto const& b = proxies[members[j]];
+                        // Pairs sharing several cells are only reported by the first cell of their common range
+                        if(cell.x != std::max(a.cells.min_x, b.cells.min_x) || cell.y != std::max(a.cells.min_y, b.cells.min_y)) {
+                            continue;
+                        }
+                        if(!can_collide(a.filter, b.filter) || !a.box.overlaps(b.box)) {
+                            continue;
+                        }
+                        if(count < static_cast<std::size_t>(out.size())) {
+                            out[count] = proxy_pair{std::min(members[i], members[j]), std::max(members[i], members[j])};
+                        }
+                        ++count;
+                    }
+                }
+            }
+            for(auto const i : large_proxies) {
+                for(std::uint32_t j = 0; j < proxies.size(); ++j) {
+                    // Pairs of large proxies are reported by the lower index
+                    if(j == i || (proxies[j].large && j < i)) {
+                        continue;
+                    }
+                    add_pair(out, count, i, j);
+                }
+            }
+            return count;
+        }
+
+        // Same as above, restricted to pairs with at least one awake proxy. awake flags every proxy, and active lists the
+        // awake ones. Only the cells of active proxies are visited, so sleeping proxies cost nothing unless an awake one
+        // shares their cell
+        auto find_pairs(range::contiguous_view<proxy_pair> out, range::contiguous_view<std::uint8_t const> awake,
+                        range::contiguous_view<std::uint32_t const> active) const -> std::size_t {
+            Expects(static_cast<std::size_t>(awake.size()) >= proxies.size());
+            auto count = std::size_t(0);
+            for(auto const i : active) {
+                if(i >= proxies.size() || proxies[i].large) {
+                    continue;
+                }
+                auto const& a = proxies[i];
+                for(auto y = a.cells.min_y; y <= a.cells.max_y; ++y) {
+                    for(auto x = a.cells.min_x; x <= a.cells.max_x; ++x) {
+                        for(auto const j : cells.find(pack(x, y))->second) {
+                            // Pairs of awake proxies are reported by the lower index
+                            if(j == i || (awake[j] && j < i)) {
+                                continue;
+                            }
+                            auto const& b = proxies[j];
+                            if(x != std::max(a.cells.min_x, b.cells.min_x) || y != std::max(a.cells.min_y, b.cells.min_y)) {
+                                continue;
+                            }
+                            if(!can_collide(a.filter, b.filter) || !a.box.overlaps(b.box)) {
+                                continue;
+                            }
+                            if(count < static_cast<std::size_t>(out.size())) {
+                                out[count] = proxy_pair{std::min(i, j), std::max(i, j)};
+                            }
+                            ++count;
+                        }
+                    }
+                }
+            }
+            // An awake large proxy is tested against every proxy, a sleeping one only against the awake ones. Either way
+            // the lower index of a pair of large proxies sees the other, so it reports the pair
+            for(auto const i : large_proxies) {
+                auto const consider = [&] (std::uint32_t j) {
+                    if(j == i || (!awake[i] && !awake[j]) || (proxies[j].large && j < i)) {
+                        return;
+                    }
+                    add_pair(out, count, i, j);
+                };
+                if(awake[i]) {
+                    for(std::uint32_t j = 0; j < proxies.size(); ++j) {
+                        consider(j);
+                    }
+                } else {
+                    for(auto const j : active) {
+                        if(j < proxies.size()) {
+                            consider(j);
+                        }
+                    }
+                }
+            }
+            return count;
+        }
+
+    private:
+        struct cell_range {
+            std::int32_t min_x, min_y, max_x, max_y;
+
+            auto operator!=(cell_range const& other) const noexcept -> bool {
+                return min_x != other.min_x || min_y != other.min_y || max_x != other.max_x || max_y != other.max_y;
+            }
+        };
+
+        struct cell_coordinate {
+            std::int32_t x, y;
+        };
+
+        struct proxy {
+            aabb2d box;
+            cell_range cells;
+            collision_filter filter;
+            // Kept in large_proxies instead of the cells
+            bool large = false;
+        };
+
+        // Saturates, NaN included, so the conversion is always defined. One short of the int32 range, so that loops over
+        // a cell range can step past its last cell
+        static constexpr std::int32_t max_cell = std::numeric_limits<std::int32_t>::max() - 1;
+
+        auto get_cell(double coordinate) const noexcept -> std::int32_t {
+            auto const cell = std::floor(coordinate / cell_size);
+            if(!(cell > -max_cell)) {
+                return -max_cell;
+            }
+            if(cell >= max_cell) {
+                return max_cell;
+            }
+            return static_cast<std::int32_t>(cell);
+        }
+
+        auto get_cell_range(aabb2d const& box) const noexcept -> cell_range {
+            return cell_range{get_cell(box.min.x), get_cell(box.min.y), get_cell(box.max.x), get_cell(box.max.y)};
+        }
+
+        static auto is_large(cell_range const& range) noexcept -> bool {
+            auto const width = std::int64_t(range.max_x) - range.min_x + 1;
+            auto const height = std::int64_t(range.max_y) - range.min_y + 1;
+            return width > max_cells_per_proxy || height > max_cells_per_proxy || width * height > max_cells_per_proxy;
+        }
+
+        void add_pair(range::contiguous_view<proxy_pair> out, std::size_t & count, std::uint32_t i, std::uint32_t j) const noexcept {
+            auto const& a = proxies[i];
+            auto const& b = proxies[j];
+            if(!can_collide(a.filter, b.filter) || !a.box.overlaps(b.box)) {
+                return;
+            }
+            if(count < static_cast<std::size_t>(out.size())) {
+                out[count] = proxy_pair{std::min(i, j), std::max(i, j)};
+            }
+            ++count;
+        }
+
+        static auto pack(std::int32_t x, std::int32_t y) noexcept -> std::uint64_t {
+            return (std::uint64_t(std::uint32_t(x)) << 32) | std::uint32_t(y);
+        }
+        static auto unpack(std::uint64_t key) noexcept -> cell_coordinate {
+            return cell_coordinate{std::int32_t(std::uint32_t(key >> 32)), std::int32_t(std::uint32_t(key))};
+        }
+
+        void add_to_cells(std::uint32_t index) {
+            auto & p = proxies[index];
+            p.large = is_large(p.cells);
+            if(p.large) {
+                large_proxies.push_back(index);
+                return;
+            }
+            auto const& range = p.cells;
+            for(auto y = range.min_y; y <= range.max_y; ++y) {
+                for(auto x = range.min_x; x <= range.max_x; ++x) {
+                    cells[pack(x, y)].push_back(index);
+                }
+            }
+        }
+
+        void remove_from_cells(std::uint32_t index) {
+            if(proxies[index].large) {
+                auto const it = std::find(large_proxies.begin(), large_proxies.end(), index);
+                *it = large_proxies.back();
+                large_proxies.pop_back();
+                return;
+            }
+            auto const& range = proxies[index].cells;
+            for(auto y = range.min_y; y <= range.max_y; ++y) {
+                for(auto x = range.min_x; x <= range.max_x; ++x) {
+                    auto const it = cells.find(pack(x, y));
+                    auto & members = it->second;
+                    auto const member = std::find(members.begin(), members.end(), index);
+                    *member = members.back();
+                    members.pop_back();
+                    if(members.empty()) {
+                        cells.erase(it);
+                    }
+                }
+            }
+        }
+
+        double cell_size;
+        std::vector<proxy> proxies;
+        std::unordered_map<std::uint64_t, std::vector<std::uint32_t>> cells;
+        std::vector<std::uint32_t> large_proxies;
+    };
+}
@@ -0,0 +1,168 @@
+#pragma once
+
+#include <algorithm>
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+#include "common/range/view.h"
+#include "physics/aabb.h"
+#include "physics/aabb_tree.h"
+#include "physics/body_storage.h"
+#include "physics/broad_phase.h"
+#include "physics/contact.h"
+#include "physics/contact_solver.h"
+
+namespace hz::physics {
+    // Broad phase, narrow phase and contact solver run in sequence over a body storage, body i being proxy i.
+    // Only awake bodies are moved in the broad phase, and pairs of sleeping or static bodies are never tested.
+    // A bounding volume tree of every body answers point, box and ray queries. Each step records which bodies moved, and
+    // the tree is refit from them when next queried, since refitting every falling body each tick costs as much as the step
+    class collision_system {
+    public:
+        explicit collision_system(double cell_size, contact_solver_settings settings = {})
+            : broad_phase(cell_size)
+            , solver(settings) {
+
+        }
+
+        void set_filter(std::uint32_t body, collision_filter filter) {
+            if(filters.size() <= body) {
+                filters.resize(body + 1);
+            }
+            filters[body] = filter;
+            filters_changed = true;
+        }
+
+        // Takes every body flagged awake as active, for callers without a sleep system
+        void step(body_storage2d & bodies) {
+            auto const awake = std::as_const(bodies).get_awake();
+            awake_bodies.clear();
+            for(std::uint32_t i = 0; i < awake.size(); ++i) {
+                if(awake[i]) {
+                    awake_bodies.push_back(i);
+                }
+            }
+            step(bodies, awake_bodies);
+        }
+
+        // active lists the awake bodies in index order, as kept by the sleep system, so that sleeping bodies cost nothing
+        void step(body_storage2d & bodies, range::contiguous_view<std::uint32_t const> active) {
+            std::swap(contacts, previous_contacts);
+            contacts.clear();
+
+            auto const positions = bodies.get_positions();
+            auto const dimensions = std::as_const(bodies).get_dimensions();
+            auto const awake = std::as_const(bodies).get_awake();
+            broad_phase.update(positions, dimensions, active);
+            if(filters_changed) {
+                for(std::uint32_t i = 0; i < filters.size() && i < broad_phase.size(); ++i) {
+                    broad_phase.set_filter(i, filters[i]);
+                }
+                filters_changed = filters.size() > broad_phase.size();
+            }
+
+            find_pairs(awake, active);
+            auto const weights = bodies.get_weights();
+            for(auto const& pair : pairs) {
+                if(get_inverse_mass(weights[pair.first]) + get_inverse_mass(weights[pair.second]) <= 0.0) {
+                    continue;
+                }
+                auto const m = collide(make_aabb(positions[pair.first], dimensions[pair.first]), make_aabb(positions[pair.second], dimensions[pair.second]));
+                if(m) {
+                    contacts.push_back(contact{pair.first, pair.second, m->normal, m->penetration});
+                    warm_start(contacts.back());
+                }
+            }
+
+            solver.solve(bodies, contacts);
+            mark_moved(active);
+        }
+
+        // Contacts of the last step, sorted by body pair
+        auto get_contacts() const noexcept -> range::contiguous_view<contact const> {
+            return contacts;
+        }
+
+        // Queries take the bodies last stepped, and see them as they were at the end of that step. They write body indices
+        // into out and return the total number of results, which can be larger than out
+        auto query(body_storage2d const& bodies, vector2d point, range::contiguous_view<std::uint32_t> out) -> std::size_t {
+            refit_tree(bodies);
+            return tree.query(point, out);
+        }
+        auto query(body_storage2d const& bodies, aabb2d const& box, range::contiguous_view<std::uint32_t> out) -> std::size_t {
+            refit_tree(bodies);
+            return tree.query(box, out);
+        }
+        auto raycast(body_storage2d const& bodies, vector2d from, vector2d to, range::contiguous_view<ray_hit> out) -> std::size_t {
+            refit_tree(bodies);
+            return tree.raycast(from, to, out);
+        }
+
+    private:
+        // Bodies only move when awake or pushed by a contact
+        void mark_moved(range::contiguous_view<std::uint32_t const> active) {
+            auto const mark = [this] (std::uint32_t body) {
+                if(body < tree_proxies.size() && !moved_flags[body]) {
+                    moved_flags[body] = 1;
+                    moved_bodies.push_back(body);
+                }
+            };
+            for(auto const body : active) {
+                mark(body);
+            }
+            for(auto const& c : contacts) {
+                mark(c.a);
+                mark(c.b);
+            }
+        }
+
+        void refit_tree(body_storage2d const& bodies) {
+            auto const positions = bodies.get_positions();
+            auto const dimensions = bodies.get_dimensions();
+            for(auto const body : moved_bodies) {
+                tree.move(tree_proxies[body], make_aabb(positions[body], dimensions[body]));
+                moved_flags[body] = 0;
+            }
+            moved_bodies.clear();
+            for(auto body = static_cast<std::uint32_t>(tree_proxies.size()); body < positions.size(); ++body) {
+                tree_proxies.push_back(tree.insert(make_aabb(positions[body], dimensions[body]), body));
+            }
+            moved_flags.resize(tree_proxies.size());
+        }
+
+        void find_pairs(range::contiguous_view<std::uint8_t const> awake, range::contiguous_view<std::uint32_t const> active) {
+            pairs.resize(std::max<std::size_t>(pairs.capacity(), 64));
+            auto count = broad_phase.find_pairs(pairs, awake, active);
+            if(count > pairs.size()) {
+                pairs.resize(count);
+                count = broad_phase.find_pairs(pairs, awake, active);
+            }
+            pairs.resize(count);
+        }
+
+        // Previous contacts are sorted by pair, as left by the solver
+        void warm_start(contact & c) const noexcept {
+            auto const it = std::lower_bound(previous_contacts.begin(), previous_contacts.end(), c, [] (contact const& lhs, contact const& rhs) {
+                return lhs.a < rhs.a || (lhs.a == rhs.a && lhs.b < rhs.b);
+            });
+            if(it != previous_contacts.end() && it->a == c.a && it->b == c.b && it->normal == c.normal) {
+                c.normal_impulse = it->normal_impulse;
+                c.tangent_impulse = it->tangent_impulse;
+            }
+        }
+
+        spatial_hash broad_phase;
+        contact_solver solver;
+        std::vector<collision_filter> filters;
+        bool filters_changed = false;
+        std::vector<std::uint32_t> awake_bodies;
+        std::vector<proxy_pair> pairs;
+        std::vector<contact> contacts;
+        std::vector<contact> previous_contacts;
+        aabb_tree tree;
+        std::vector<aabb_tree::proxy_id> tree_proxies;
+        std::vector<std::uint8_t> moved_flags;
+        std::vector<std::uint32_t> moved_bodies;
+    };
+}
@@ -0,0 +1,41 @@
+#pragma once
+
+#include <cmath>
+#include <cstdint>
+#include <optional>
+
+#include "physics/aabb.h"
+
+namespace hz::physics {
+    // Contact between bodies a and b. The normal points from a to b
+    struct contact {
+        std::uint32_t a;
+        std::uint32_t b;
+        vector2d normal;
+        double penetration;
+        // Accumulated by the solver, and carried over between ticks for warm starting
+        double normal_impulse = 0.0;
+        double tangent_impulse = 0.0;
+    };
+
+    struct manifold {
+        vector2d normal;
+        double penetration;
+    };
+
+    // Boxes do not rotate, so a single normal and depth along the axis of least overlap describe the whole contact
+    inline auto collide(aabb2d const& a, aabb2d const& b) noexcept -> std::optional<manifold> {
+        auto const distance = b.get_center() - a.get_center();
+        auto const half_extents = (a.get_extent() + b.get_extent()) / 2.0;
+        auto const overlap_x = half_extents.x - std::abs(distance.x);
+        auto const overlap_y = half_extents.y - std::abs(distance.y);
+        if(overlap_x < 0.0 || overlap_y < 0.0) {
+            return std::nullopt;
+        }
+
+        if(overlap_x < overlap_y) {
+            return manifold{vector2d{distance.x < 0.0 ? -1.0 : 1.0, 0.0}, overlap_x};
+        }
+        return manifold{vector2d{0.0, distance.y < 0.0 ? -1.0 : 1.0}, overlap_y};
+    }
+}
@@ -0,0 +1,187 @@
+#pragma once
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <vector>
+
+#include "common/range/view.h"
+#include "physics/body_storage.h"
+#include "physics/contact.h"
+
+namespace hz::physics {
+    struct contact_solver_settings {
+        int velocity_iterations = 8;
+        int position_iterations = 3;
+        // Approach speeds below this do not bounce, which keeps resting stacks from jittering
+        double restitution_threshold = 1.0;
+        // Fraction of the penetration beyond the slop removed by each position iteration
+        double position_correction = 0.8;
+        double slop = 0.01;
+    };
+
+    // Sequential impulse solver. Contacts are sorted by body pair, and the velocities and inverse masses of the bodies they
+    // touch are gathered into one dense array, so the iterations only walk two small contiguous arrays.
+    // Impulses from the previous tick seed matching contacts, which lets stacks settle in few iterations
+    class contact_solver {
+    public:
+        explicit contact_solver(contact_solver_settings settings = {}) noexcept
+            : settings(settings) {
+
+        }
+
+        auto get_settings() const noexcept -> contact_solver_settings const& {
+            return settings;
+        }
+
+        // Applies the contact impulses to the bodies' velocities, then pushes overlapping bodies apart along the contact normals.
+        // The contacts are reordered and keep their final impulses
+        void solve(body_storage2d & bodies, range::contiguous_view<contact> contacts) {
+            std::sort(contacts.begin(), contacts.end(), [] (contact const& lhs, contact const& rhs) {
+                return lhs.a < rhs.a || (lhs.a == rhs.a && lhs.b < rhs.b);
+            });
+
+            gather(bodies, contacts);
+            prepare(bodies, contacts);
+            for(int i = 0; i < settings.velocity_iterations; ++i) {
+                solve_velocities();
+            }
+            for(int i = 0; i < settings.position_iterations; ++i) {
+                solve_positions();
+            }
+            scatter(bodies, contacts);
+        }
+
+    private:
+        struct solver_body {
+            vector2d velocity;
+            double inverse_mass;
+            vector2d correction;
+        };
+
+        struct constraint {
+            std::uint32_t a;
+            std::uint32_t b;
+            vector2d normal;
+            double mass;
+            double bias;
+            double friction;
+            double normal_impulse;
+            double tangent_impulse;
+            double penetration;
+        };
+
+        void gather(body_storage2d const& bodies, range::contiguous_view<contact const> contacts) {
+            solver_index.resize(bodies.size(), unused);
+            solver_bodies.clear();
+            body_indices.clear();
+
+            auto const velocities = bodies.get_velocities();
+            auto const weights = bodies.get_weights();
+            auto const add = [&] (std::uint32_t body) {
+                if(solver_index[body] == unused) {
+                    solver_index[body] = static_cast<std::uint32_t>(solver_bodies.size());
+                    solver_bodies.push_back(solver_body{velocities[body].value, get_inverse_mass(weights[body]), vector2d{}});
+                    body_indices.push_back(body);
+                }
+                return solver_index[body];
+            };
+
+            constraints.clear();
+            for(auto const& c : contacts) {
+                constraints.push_back(constraint{add(c.a), add(c.b), c.normal, 0.0, 0.0, 0.0, 0.0, 0.0, c.penetration});
+            }
+        }
+
+        void prepare(body_storage2d const& bodies, range::contiguous_view<contact const> contacts) {
+            auto const materials = bodies.get_materials();
+            for(std::size_t i = 0; i < constraints.size(); ++i) {
+                auto & k = constraints[i];
+                auto const& c = contacts[i];
+                auto const& a = solver_bodies[k.a];
+                auto const& b = solver_bodies[k.b];
+
+                auto const inverse_mass_sum = a.inverse_mass + b.inverse_mass;
+                k.mass = inverse_mass_sum > 0.0 ? 1.0 / inverse_mass_sum : 0.0;
+                k.friction = std::sqrt(materials[c.a].friction * materials[c.b].friction);
+
+                auto const approach_speed = math::scalar_product(b.velocity - a.velocity, k.normal);
+                auto const restitution = std::max(materials[c.a].restitution, materials[c.b].restitution);
+                k.bias = approach_speed < -settings.restitution_threshold ? -restitution * approach_speed : 0.0;
+
+                k.normal_impulse = c.normal_impulse;
+                k.tangent_impulse = c.tangent_impulse;
+                apply_impulse(k, k.normal * k.normal_impulse + tangent(k.normal) * k.tangent_impulse);
+            }
+        }
+
+        void solve_velocities() noexcept {
+            for(auto & k : constraints) {
+                auto const& a = solver_bodies[k.a];
+                auto const& b = solver_bodies[k.b];
+                auto const relative_velocity = b.velocity - a.velocity;
+
+                auto const t = tangent(k.normal);
+                auto const tangent_lambda = -k.mass * math::scalar_product(relative_velocity, t);
+                auto const max_friction = k.friction * k.normal_impulse;
+                auto const new_tangent_impulse = std::clamp(k.tangent_impulse + tangent_lambda, -max_friction, max_friction);
+                auto const tangent_delta = new_tangent_impulse - k.tangent_impulse;
+                k.tangent_impulse = new_tangent_impulse;
+
+                auto const normal_lambda = k.mass * (k.bias - math::scalar_product(relative_velocity, k.normal));
+                auto const new_normal_impulse = std::max(k.normal_impulse + normal_lambda, 0.0);
+                auto const normal_delta = new_normal_impulse - k.normal_impulse;
+                k.normal_impulse = new_normal_impulse;
+
+                apply_impulse(k, k.normal * normal_delta + t * tangent_delta);
+            }
+        }
+
+        // Penetration is re-evaluated from the corrections applied so far, so that stacked contacts converge together
+        void solve_positions() noexcept {
+            for(auto const& k : constraints) {
+                auto & a = solver_bodies[k.a];
+                auto & b = solver_bodies[k.b];
+                auto const penetration = k.penetration - math::scalar_product(b.correction - a.correction, k.normal);
+                auto const depth = penetration - settings.slop;
+                if(depth <= 0.0) {
+                    continue;
+                }
+                auto const correction = k.normal * (depth * settings.position_correction * k.mass);
+                a.correction -= correction * a.inverse_mass;
+                b.correction += correction * b.inverse_mass;
+            }
+        }
+
+        void scatter(body_storage2d & bodies, range::contiguous_view<contact> contacts) {
+            auto const positions = bodies.get_positions();
+            auto const velocities = bodies.get_velocities();
+            for(std::size_t i = 0; i < solver_bodies.size(); ++i) {
+                positions[body_indices[i]].value += solver_bodies[i].correction;
+                velocities[body_indices[i]].value = solver_bodies[i].velocity;
+                solver_index[body_indices[i]] = unused;
+            }
+            for(std::size_t i = 0; i < constraints.size(); ++i) {
+                contacts[i].normal_impulse = constraints[i].normal_impulse;
+                contacts[i].tangent_impulse = constraints[i].tangent_impulse;
+            }
+        }
+
+        void apply_impulse(constraint const& k, vector2d impulse) noexcept {
+            solver_bodies[k.a].velocity -= impulse * solver_bodies[k.a].inverse_mass;
+            solver_bodies[k.b].velocity += impulse * solver_bodies[k.b].inverse_mass;
+        }
+
+        static constexpr auto tangent(vector2d normal) noexcept -> vector2d {
+            return vector2d{-normal.y, normal.x};
+        }
+
+        static constexpr std::uint32_t unused = 0xFFFFFFFF;
+
+        contact_solver_settings settings;
+        std::vector<solver_body> solver_bodies;
+        std::vector<std::uint32_t> body_indices;
+        std::vector<std::uint32_t> solver_index;
+        std::vector<constraint> constraints;
+    };
+}
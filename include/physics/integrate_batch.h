@@ -0,0 +1,161 @@
+#pragma once
+
+#include <cstddef>
+#include <tuple>
+
+#if defined(__AVX__)
+#include <immintrin.h>
+#elif defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define HZ_PHYSICS_SSE2 1
+#endif
+
+#include <gsl/gsl_assert>
+
+#include "common/range/view.h"
+#include "math/fixed.h"
+#include "physics/body.h"
+
+namespace hz::physics {
+    static_assert(sizeof(position2d) == 2 * sizeof(double) && sizeof(velocity2d) == 2 * sizeof(double) && sizeof(acceleration2d) == 2 * sizeof(double),
+        "integrate_batch reads quantity columns as flat arrays of double");
+    static_assert(sizeof(basic_position2d<float>) == 2 * sizeof(float) && sizeof(basic_velocity2d<float>) == 2 * sizeof(float) && sizeof(basic_acceleration2d<float>) == 2 * sizeof(float),
+        "integrate_batch reads quantity columns as flat arrays of float");
+    static_assert(sizeof(basic_position2d<math::fixed>) == 2 * sizeof(math::fixed) && sizeof(basic_velocity2d<math::fixed>) == 2 * sizeof(math::fixed) && sizeof(basic_acceleration2d<math::fixed>) == 2 * sizeof(math::fixed),
+        "integrate_batch reads quantity columns as flat arrays of fixed");
+
+    namespace detail {
+        // Every lane does the exact operations of integrate(basic_body2d<T>, seconds): v += a*h, p += v*dt, v += a*h.
+        // Results only stay bit-identical as long as the compiler does not contract them into fused multiply-adds
+        template<typename T>
+        inline void integrate_batch_scalar(T * p, T * v, T const* a, std::ptrdiff_t begin, std::ptrdiff_t end, T dt, T half_dt) noexcept {
+            for(auto i = begin; i < end; ++i) {
+                v[i] = v[i] + a[i] * half_dt;
+                p[i] = p[i] + v[i] * dt;
+                v[i] = v[i] + a[i] * half_dt;
+            }
+        }
+
+        inline auto integrate_batch_simd(double * p, double * v, double const* a, std::ptrdiff_t n, double dt, double half_dt) noexcept -> std::ptrdiff_t {
+#if defined(__AVX__)
+            auto const dt_lanes = _mm256_set1_pd(dt);
+            auto const half_dt_lanes = _mm256_set1_pd(half_dt);
+            auto i = std::ptrdiff_t(0);
+            for(; i + 4 <= n; i += 4) {
+                auto const acc = _mm256_loadu_pd(a + i);
+                auto vel = _mm256_loadu_pd(v + i);
+                vel = _mm256_add_pd(vel, _mm256_mul_pd(acc, half_dt_lanes));
+                auto const pos = _mm256_add_pd(_mm256_loadu_pd(p + i), _mm256_mul_pd(vel, dt_lanes));
+                vel = _mm256_add_pd(vel, _mm256_mul_pd(acc, half_dt_lanes));
+                _mm256_storeu_pd(p + i, pos);
+                _mm256_storeu_pd(v + i, vel);
+            }
+            return i;
+#elif defined(HZ_PHYSICS_SSE2)
+            auto const dt_lanes = _mm_set1_pd(dt);
+            auto const half_dt_lanes = _mm_set1_pd(half_dt);
+            auto i = std::ptrdiff_t(0);
+            for(; i + 2 <= n; i += 2) {
+                auto const acc = _mm_loadu_pd(a + i);
+                auto vel = _mm_loadu_pd(v + i);
+                vel = _mm_add_pd(vel, _mm_mul_pd(acc, half_dt_lanes));
+                auto const pos = _mm_add_pd(_mm_loadu_pd(p + i), _mm_mul_pd(vel, dt_lanes));
+                vel = _mm_add_pd(vel, _mm_mul_pd(acc, half_dt_lanes));
+                _mm_storeu_pd(p + i, pos);
+                _mm_storeu_pd(v + i, vel);
+            }
+            return i;
+#else
+            (void)p, (void)v, (void)a, (void)n, (void)dt, (void)half_dt;
+            return 0;
+#endif
+        }
+
+        inline auto integrate_batch_simd(float * p, float * v, float const* a, std::ptrdiff_t n, float dt, float half_dt) noexcept -> std::ptrdiff_t {
+#if defined(__AVX__)
+            auto const dt_lanes = _mm256_set1_ps(dt);
+            auto const half_dt_lanes = _mm256_set1_ps(half_dt);
+            auto i = std::ptrdiff_t(0);
+            for(; i + 8 <= n; i += 8) {
+                auto const acc = _mm256_loadu_ps(a + i);
+                auto vel = _mm256_loadu_ps(v + i);
+                vel = _mm256_add_ps(vel, _mm256_mul_ps(acc, half_dt_lanes));
+                auto const pos = _mm256_add_ps(_mm256_loadu_ps(p + i), _mm256_mul_ps(vel, dt_lanes));
+                vel = _mm256_add_ps(vel, _mm256_mul_ps(acc, half_dt_lanes));
+                _mm256_storeu_ps(p + i, pos);
+                _mm256_storeu_ps(v + i, vel);
+            }
+            return i;
+#elif defined(HZ_PHYSICS_SSE2)
+            auto const dt_lanes = _mm_set1_ps(dt);
+            auto const half_dt_lanes = _mm_set1_ps(half_dt);
+            auto i = std::ptrdiff_t(0);
+            for(; i + 4 <= n; i += 4) {
+                auto const acc = _mm_loadu_ps(a + i);
+                auto vel = _mm_loadu_ps(v + i);
+                vel = _mm_add_ps(vel, _mm_mul_ps(acc, half_dt_lanes));
+                auto const pos = _mm_add_ps(_mm_loadu_ps(p + i), _mm_mul_ps(vel, dt_lanes));
+                vel = _mm_add_ps(vel, _mm_mul_ps(acc, half_dt_lanes));
+                _mm_storeu_ps(p + i, pos);
+                _mm_storeu_ps(v + i, vel);
+            }
+            return i;
+#else
+            (void)p, (void)v, (void)a, (void)n, (void)dt, (void)half_dt;
+            return 0;
+#endif
+        }
+
+        // SSE2 and AVX2 have no 64x64 bit high multiply, so fixed point columns only take the scalar loop
+        inline auto integrate_batch_simd(math::fixed *, math::fixed *, math::fixed const*, std::ptrdiff_t, math::fixed, math::fixed) noexcept -> std::ptrdiff_t {
+            return 0;
+        }
+
+        template<typename T>
+        inline void integrate_batch(range::contiguous_view<basic_position2d<T>> positions, range::contiguous_view<basic_velocity2d<T>> velocities, range::contiguous_view<basic_acceleration2d<T> const> accelerations, seconds dt) noexcept {
+            Expects(positions.size() == velocities.size() && positions.size() == accelerations.size());
+
+            auto const p = reinterpret_cast<T*>(positions.data());
+            auto const v = reinterpret_cast<T*>(velocities.data());
+            auto const a = reinterpret_cast<T const*>(accelerations.data());
+            auto const n = positions.size() * 2;
+            // Same conversions as the quantity operators, so that both paths multiply by the same rounded steps
+            auto const full_dt = static_cast<T>(dt.count());
+            auto const half_dt = static_cast<T>((dt / 2).count());
+
+            auto const simd_end = integrate_batch_simd(p, v, a, n, full_dt, half_dt);
+            integrate_batch_scalar(p, v, a, simd_end, n, full_dt, half_dt);
+        }
+    }
+
+    // Kick-drift-kick over whole columns, bit-identical to calling integrate(body2d, seconds) on each body
+    inline void integrate_batch(range::contiguous_view<position2d> positions, range::contiguous_view<velocity2d> velocities, range::contiguous_view<acceleration2d const> accelerations, seconds dt) noexcept {
+        detail::integrate_batch(positions, velocities, accelerations, dt);
+    }
+
+    // Single precision columns: twice the bodies per SIMD register, bit-identical to integrate(body2f, seconds)
+    inline void integrate_batch(range::contiguous_view<basic_position2d<float>> positions, range::contiguous_view<basic_velocity2d<float>> velocities, range::contiguous_view<basic_acceleration2d<float> const> accelerations, seconds dt) noexcept {
+        detail::integrate_batch(positions, velocities, accelerations, dt);
+    }
+
+    // Fixed point columns, giving the same bits as integrate(basic_body2d<math::fixed>, seconds) on every platform
+    inline void integrate_batch(range::contiguous_view<basic_position2d<math::fixed>> positions, range::contiguous_view<basic_velocity2d<math::fixed>> velocities, range::contiguous_view<basic_acceleration2d<math::fixed> const> accelerations, seconds dt) noexcept {
+        detail::integrate_batch(positions, velocities, accelerations, dt);
+    }
+
+    // Batch form of integrate<Integrator>(body2d, field, seconds). The field is called once per body and evaluation, so
+    // there is no SIMD path: the field dominates the cost
+    template<typename Integrator, typename F>
+    void integrate_batch(range::contiguous_view<position2d> positions, range::contiguous_view<velocity2d> velocities, range::contiguous_view<acceleration2d const> accelerations, F && field, seconds dt) {
+        Expects(positions.size() == velocities.size() && positions.size() == accelerations.size());
+
+        auto const h = dt.count();
+        for(std::ptrdiff_t i = 0; i < positions.size(); ++i) {
+            auto const accumulated = accelerations[i].value;
+            auto const a = [&field, accumulated] (double, vector2d x, vector2d v) {
+                return accumulated + field(position2d(x), velocity2d(v)).value;
+            };
+            std::tie(positions[i].value, velocities[i].value) = Integrator::step(positions[i].value, velocities[i].value, a, 0.0, h);
+        }
+    }
+}
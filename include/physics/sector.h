@@ -0,0 +1,131 @@
+#pragma once
+
+#include <cmath>
+#include <cstdint>
+#include <initializer_list>
+
+#include "common/range/view.h"
+#include "math/vector.h"
+#include "physics/body.h"
+
+namespace hz::physics {
+    // Side of a sector. A power of two, so that moving positions by whole sectors is exact in float
+    inline constexpr double sector_size = 1024.0;
+
+    struct sector_coordinate {
+        std::int64_t x, y;
+
+        constexpr auto operator==(sector_coordinate other) const noexcept -> bool {
+            return x == other.x && y == other.y;
+        }
+        constexpr auto operator!=(sector_coordinate other) const noexcept -> bool {
+            return !(*this == other);
+        }
+    };
+
+    // Large-world position: an integer sector plus a single precision offset inside it. The offset never grows past one
+    // sector, so it keeps the same absolute precision (about 1e-4 with the default size) at any distance from the origin
+    struct sector_position2d {
+        sector_coordinate sector = {};
+        math::vector2f offset = {};
+    };
+
+    namespace detail {
+        inline void split_axis(double value, std::int64_t & sector, float & offset) noexcept {
+            auto const whole = std::floor(value / sector_size);
+            sector += static_cast<std::int64_t>(whole);
+            offset = static_cast<float>(value - whole * sector_size);
+            // Values just below a sector boundary, like -1e-9, round up to a whole sector in float
+            if(offset >= static_cast<float>(sector_size)) {
+                offset -= static_cast<float>(sector_size);
+                ++sector;
+            }
+        }
+    }
+
+    // Moves whole sectors out of the offset, leaving it in [0, sector_size)
+    inline auto normalize(sector_position2d p) noexcept -> sector_position2d {
+        detail::split_axis(p.offset.x, p.sector.x, p.offset.x);
+        detail::split_axis(p.offset.y, p.sector.y, p.offset.y);
+        return p;
+    }
+
+    inline auto to_sector_position(math::vector2d world) noexcept -> sector_position2d {
+        auto p = sector_position2d();
+        detail::split_axis(world.x, p.sector.x, p.offset.x);
+        detail::split_axis(world.y, p.sector.y, p.offset.y);
+        return p;
+    }
+
+    // Only as precise as a double at that distance from the world origin
+    inline auto to_world(sector_position2d p) noexcept -> math::vector2d {
+        return math::vector2d{p.sector.x * sector_size + p.offset.x, p.sector.y * sector_size + p.offset.y};
+    }
+
+    // Single precision coordinates relative to the corner of the origin sector. The sector difference is taken in
+    // integers, so the result is exact up to float rounding of the local value
+    inline auto to_local(sector_position2d p, sector_coordinate origin) noexcept -> math::vector2f {
+        return math::vector2f{
+            static_cast<float>(static_cast<double>(p.sector.x - origin.x) * sector_size + p.offset.x),
+            static_cast<float>(static_cast<double>(p.sector.y - origin.y) * sector_size + p.offset.y),
+        };
+    }
+
+    inline auto from_local(math::vector2f local, sector_coordinate origin) noexcept -> sector_position2d {
+        return normalize(sector_position2d{origin, local});
+    }
+
+    // Lets bodies be stored and simulated in float coordinates relative to an origin sector that follows the camera.
+    // Once the camera strays further than the rebase distance, the origin jumps to the camera's sector and every local
+    // position is shifted by the same whole number of sectors, so float precision is only ever spent near the camera
+    class floating_origin {
+    public:
+        explicit floating_origin(sector_coordinate origin = {}, double rebase_distance = 4.0 * sector_size) noexcept
+            : origin(origin)
+            , rebase_distance(rebase_distance) {
+
+        }
+
+        auto get_origin() const noexcept -> sector_coordinate {
+            return origin;
+        }
+
+        auto to_local(sector_position2d p) const noexcept -> math::vector2f {
+            return physics::to_local(p, origin);
+        }
+        auto to_sector_position(math::vector2f local) const noexcept -> sector_position2d {
+            return from_local(local, origin);
+        }
+
+        // Rebases around the camera, given in local coordinates, when it has moved too far. Returns whether the origin moved,
+        // in which case the camera and all positions were shifted to the new origin
+        auto update(math::vector2f & camera, range::contiguous_view<basic_position2d<float>> positions) noexcept -> bool {
+            return update(camera, {positions});
+        }
+
+        // Same as above, for positions kept in several columns, such as the positions before and after a tick that get
+        // blended for rendering. Every column holding local positions must be passed, or blending crosses the rebase
+        auto update(math::vector2f & camera, std::initializer_list<range::contiguous_view<basic_position2d<float>>> columns) noexcept -> bool {
+            if(std::abs(camera.x) <= rebase_distance && std::abs(camera.y) <= rebase_distance) {
+                return false;
+            }
+
+            auto const sectors_x = static_cast<std::int64_t>(std::floor(camera.x / sector_size));
+            auto const sectors_y = static_cast<std::int64_t>(std::floor(camera.y / sector_size));
+            auto const shift = math::vector2f{static_cast<float>(sectors_x * sector_size), static_cast<float>(sectors_y * sector_size)};
+            for(auto const positions : columns) {
+                for(auto & p : positions) {
+                    p.value -= shift;
+                }
+            }
+            camera -= shift;
+            origin.x += sectors_x;
+            origin.y += sectors_y;
+            return true;
+        }
+
+    private:
+        sector_coordinate origin;
+        double rebase_distance;
+    };
+}
@@ -0,0 +1,270 @@
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <utility>
+#include <vector>
+
+#include "common/range/view.h"
+#include "physics/body_storage.h"
+#include "physics/contact.h"
+
+namespace hz::physics {
+    struct sleep_settings {
+        // Bodies slower than this count as still
+        double velocity_threshold = 0.05;
+        // An island falls asleep once every body in it has been still for this many ticks
+        std::uint32_t ticks_to_sleep = 30;
+    };
+
+    // Puts islands of touching bodies to sleep once they have all been still for a while, and wakes a whole island when
+    // one of its bodies is woken or touched by an awake body. Sleeping bodies are left out of integration and collision,
+    // so the per tick cost only depends on the awake bodies: the awake bodies are kept as a sorted active list, updated
+    // as islands wake and fall asleep, and woken bodies come from the storage's wake list. Static bodies form an island
+    // of their own that never wakes up through contacts
+    class sleep_system {
+    public:
+        explicit sleep_system(sleep_settings settings = {}) noexcept
+            : settings(settings) {
+
+        }
+
+        auto get_settings() const noexcept -> sleep_settings const& {
+            return settings;
+        }
+
+        auto get_awake_count() const noexcept -> std::size_t {
+            return active.size();
+        }
+
+        // Awake bodies in index order
+        auto get_active() const noexcept -> range::contiguous_view<std::uint32_t const> {
+            return active;
+        }
+
+        // Wakes the islands of bodies woken through body2d_ref::wake since the last call, and picks up new bodies.
+        // Run it after forces are applied and before integrating
+        void wake_flagged(body_storage2d & bodies) {
+            add_new_bodies(bodies);
+            auto & woken = bodies.get_woken();
+            for(auto const body : woken.get()) {
+                if(island_of[body] != no_island) {
+                    wake_island(bodies, island_of[body]);
+                }
+            }
+            woken.clear();
+            if(active_changed) {
+                update_active(bodies);
+            }
+        }
+
+        // Counts still ticks, wakes islands touched by awake bodies, and puts islands that have been still long enough to
+        // sleep. Run it on the contacts of the collision step
+        void update(body_storage2d & bodies, range::contiguous_view<contact const> contacts) {
+            add_new_bodies(bodies);
+            auto const weights = std::as_const(bodies).get_weights();
+            auto const is_dynamic = [weights] (std::uint32_t body) { return get_inverse_mass(weights[body]) > 0.0; };
+
+            // The solver has already pushed any sleeping body touched by an awake one
+            for(auto const& c : contacts) {
+                for(auto const body : {c.a, c.b}) {
+                    if(island_of[body] != no_island && is_dynamic(body)) {
+                        wake_island(bodies, island_of[body]);
+                    }
+                }
+            }
+            if(active_changed) {
+                update_active(bodies);
+            }
+
+            auto const velocities = std::as_const(bodies).get_velocities();
+            auto const threshold = settings.velocity_threshold * settings.velocity_threshold;
+            for_each_awake([&] (std::uint32_t body) {
+                auto const v = velocities[body].value;
+                still_ticks[body] = math::scalar_product(v, v) < threshold ? std::min(still_ticks[body] + 1, settings.ticks_to_sleep) : 0;
+                parent[body] = body;
+                island_still_ticks[body] = settings.ticks_to_sleep;
+                new_island[body] = no_island;
+            });
+
+            for(auto const& c : contacts) {
+                if(is_dynamic(c.a) && is_dynamic(c.b)) {
+                    unite(c.a, c.b);
+                }
+            }
+            for(auto const& [a, b] : woken_links) {
+                if(is_dynamic(a) && is_dynamic(b)) {
+                    unite(a, b);
+                }
+            }
+            woken_links.clear();
+
+            for_each_awake([&] (std::uint32_t body) {
+                auto & island_still = island_still_ticks[find(body)];
+                island_still = std::min(island_still, still_ticks[body]);
+            });
+
+            auto const awake = bodies.get_awake();
+            auto const body_velocities = bodies.get_velocities();
+            for_each_awake([&] (std::uint32_t body) {
+                auto const root = find(body);
+                if(island_still_ticks[root] < settings.ticks_to_sleep) {
+                    return;
+                }
+                if(new_island[root] == no_island) {
+                    new_island[root] = allocate_island();
+                }
+                awake[body] = 0;
+                body_velocities[body] = velocity2d();
+                island_of[body] = new_island[root];
+                islands[new_island[root]].push_back(body);
+                active_changed = true;
+            });
+
+            if(active_changed) {
+                update_active(bodies);
+            }
+        }
+
+        // Calls f(run_begin, run_end) for each run of consecutive body indices among get_active()[first, last), to split
+        // the awake bodies in chunks of equal size
+        template<typename F>
+        void for_each_active_run(std::size_t first, std::size_t last, F && f) const {
+            while(first < last) {
+                auto const begin = active[first];
+                auto end = begin + 1;
+                for(++first; first < last && active[first] == end; ++first) {
+                    ++end;
+                }
+                f(std::size_t(begin), std::size_t(end));
+            }
+        }
+
+        // Calls f(run_begin, run_end) for each run of consecutive awake bodies within [begin, end)
+        template<typename F>
+        void for_each_awake_run(std::size_t begin, std::size_t end, F && f) const {
+            auto it = std::upper_bound(runs.begin(), runs.end(), begin, [] (std::size_t index, run const& r) {
+                return index < r.end;
+            });
+            for(; it != runs.end() && it->begin < end; ++it) {
+                f(std::max<std::size_t>(it->begin, begin), std::min<std::size_t>(it->end, end));
+            }
+        }
+
+    private:
+        struct run {
+            std::size_t begin;
+            std::size_t end;
+        };
+
+        template<typename F>
+        void for_each_awake(F && f) const {
+            for(auto const body : active) {
+                f(body);
+            }
+        }
+
+        void add_new_bodies(body_storage2d const& bodies) {
+            auto const awake = bodies.get_awake();
+            for(auto body = static_cast<std::uint32_t>(island_of.size()); body < bodies.size(); ++body) {
+                island_of.push_back(no_island);
+                still_ticks.push_back(0);
+                parent.push_back(body);
+                island_still_ticks.push_back(0);
+                new_island.push_back(no_island);
+                if(awake[body]) {
+                    woken_bodies.push_back(body);
+                } else {
+                    island_of[body] = allocate_island();
+                    islands[island_of[body]].push_back(body);
+                }
+                active_changed = true;
+            }
+        }
+
+        void wake_island(body_storage2d & bodies, std::uint32_t island) {
+            auto const awake = bodies.get_awake();
+            auto const& members = islands[island];
+            for(std::size_t i = 0; i < members.size(); ++i) {
+                awake[members[i]] = 1;
+                woken_bodies.push_back(members[i]);
+                island_of[members[i]] = no_island;
+                still_ticks[members[i]] = 0;
+                // Contacts within a sleeping island were not collected, so its members are kept together explicitly
+                if(i > 0) {
+                    woken_links.push_back({members[i - 1], members[i]});
+                }
+            }
+            islands[island].clear();
+            free_islands.push_back(island);
+            active_changed = true;
+        }
+
+        auto allocate_island() -> std::uint32_t {
+            if(free_islands.empty()) {
+                islands.emplace_back();
+                return static_cast<std::uint32_t>(islands.size() - 1);
+            }
+            auto const island = free_islands.back();
+            free_islands.pop_back();
+            return island;
+        }
+
+        // Drops the bodies that fell asleep from the active list and merges in the woken ones. Only runs when bodies fall
+        // asleep or wake up, and costs as much as the awake bodies, not all of them
+        void update_active(body_storage2d const& bodies) {
+            auto const awake = bodies.get_awake();
+            active.erase(std::remove_if(active.begin(), active.end(), [awake] (std::uint32_t body) { return awake[body] == 0; }), active.end());
+            std::sort(woken_bodies.begin(), woken_bodies.end());
+            auto const middle = active.size();
+            active.insert(active.end(), woken_bodies.begin(), woken_bodies.end());
+            std::inplace_merge(active.begin(), active.begin() + static_cast<std::ptrdiff_t>(middle), active.end());
+            woken_bodies.clear();
+
+            runs.clear();
+            for(auto const body : active) {
+                if(!runs.empty() && runs.back().end == body) {
+                    ++runs.back().end;
+                } else {
+                    runs.push_back(run{body, std::size_t(body) + 1});
+                }
+            }
+            active_changed = false;
+        }
+
+        auto find(std::uint32_t body) noexcept -> std::uint32_t {
+            while(parent[body] != body) {
+                parent[body] = parent[parent[body]];
+                body = parent[body];
+            }
+            return body;
+        }
+
+        void unite(std::uint32_t a, std::uint32_t b) noexcept {
+            auto const root_a = find(a);
+            auto const root_b = find(b);
+            if(root_a != root_b) {
+                parent[std::max(root_a, root_b)] = std::min(root_a, root_b);
+            }
+        }
+
+        static constexpr std::uint32_t no_island = std::numeric_limits<std::uint32_t>::max();
+
+        sleep_settings settings;
+        bool active_changed = false;
+        std::vector<std::uint32_t> active;
+        std::vector<std::uint32_t> woken_bodies;
+        std::vector<run> runs;
+        // Per body. Union-find state is only reset for awake bodies, so it costs nothing for sleeping ones
+        std::vector<std::uint32_t> island_of;
+        std::vector<std::uint32_t> still_ticks;
+        std::vector<std::uint32_t> parent;
+        std::vector<std::uint32_t> island_still_ticks;
+        std::vector<std::uint32_t> new_island;
+        std::vector<std::vector<std::uint32_t>> islands;
+        std::vector<std::uint32_t> free_islands;
+        std::vector<std::pair<std::uint32_t, std::uint32_t>> woken_links;
+    };
+}
@@ -1,8 +1,23 @@
 #pragma once
 
 #include <chrono>
+#include <cstdint>
 
 namespace hz::physics {
     using seconds = std::chrono::duration<double>;
     using milliseconds = std::chrono::duration<double, std::milli>;
-}
\ No newline at end of file
+
+    // The tick being simulated: its index since the start of the run, and the time step it covers.
+    // Converts from a bare time step, as tick 0, for callers that do not count ticks
+    struct tick_time {
+        template<typename Rep, typename Period>
+        tick_time(std::chrono::duration<Rep, Period> dt, std::uint64_t index = 0) noexcept
+            : dt(dt)
+            , index(index) {
+
+        }
+
+        seconds dt;
+        std::uint64_t index;
+    };
+}
@@ -0,0 +1,77 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include <expected.hpp>
+#include <gsl/span>
+
+#include <SDL.h>
+
+#include "math/vector.h"
+#include "model/simulation.h"
+#include "physics/body.h"
+#include "view/sdl/sdl.h"
+
+namespace hz::view::sdl {
+    class view_entity_t {
+    public:
+        unique_texture texture;
+        std::size_t body_index;
+    };
+
+    inline auto generate_white_texture(SDL_Renderer& renderer, int w, int h)-> tl::expected<unique_texture, int> {
+        auto texture = unique_texture(SDL_CreateTexture(&renderer, SDL_PIXELFORMAT_RGBA8888, SDL_TEXTUREACCESS_STATIC, w, h));
+        if(!texture) {
+            SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "Couldn't create texture: %s", SDL_GetError());
+            return tl::make_unexpected(-1);
+        }
+
+        auto const pixel_data = std::vector<uint32_t>(w*h, 0xFFFFFFFF);
+        if(auto const error = SDL_UpdateTexture(texture.get(), nullptr, std::data(pixel_data), w*sizeof(uint32_t)); error < 0) {
+            SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "Couldn't update texture: %s", SDL_GetError());
+            return tl::make_unexpected(error);
+        }
+
+        return texture;
+    }
+
+    inline constexpr auto window_x = 320;
+    inline constexpr auto window_y = 240;
+    inline constexpr auto camera_world_x = 100.0;
+    inline constexpr auto camera_world_y = 75.0;
+
+    inline auto integer_floor(double d) -> int {
+        return static_cast<int>(d);
+    }
+
+    // tick_fraction is how far the current time is past the snapshot's tick, in ticks, used to blend its two positions
+    inline void render_entities(gsl::span<view_entity_t> view_entities, model::body_snapshot const& bodies, double tick_fraction, SDL_Renderer & renderer) {
+        SDL_SetRenderDrawColor(&renderer, 0x00, 0x00, 0x00, 0x00);
+        SDL_RenderClear(&renderer);
+
+        for(auto const& entity : view_entities) {
+            if(entity.body_index >= bodies.positions.size()) { continue; }
+            auto const position = physics::basic_position2d<float>(math::lerp(bodies.previous_positions[entity.body_index].value, bodies.positions[entity.body_index].value, static_cast<float>(tick_fraction)));
+            auto const dimension = bodies.dimensions[entity.body_index];
+
+            auto const center_x = window_x / 2;
+            auto const center_y = window_y / 2;
+            auto const dest_target_x = center_x + integer_floor(position.value.x / camera_world_x * window_x);
+            auto const dest_target_y = center_y + integer_floor(-position.value.y / camera_world_y * window_y);
+
+            auto const render_width = integer_floor(dimension.x / camera_world_x * window_x);
+            auto const render_height = integer_floor(dimension.y / camera_world_y * window_y);
+
+            auto const dest_target = SDL_Rect{
+                dest_target_x - render_width / 2,
+                dest_target_y - render_height / 2,
+                render_width,
+                render_height,
+            };
+            SDL_RenderCopy(&renderer, entity.texture.get(), nullptr, &dest_target);
+        }
+        SDL_RenderPresent(&renderer);
+    }
+}
@@ -1,83 +1,109 @@
 #include <cstdlib>
+#include <cstdint>
+#include <cstdio>
+#include <fstream>
+#include <charconv>
 #include <chrono>
-#include <thread>
+#include <string>
 #include <string_view>
-#include <algorithm>
 #include <optional>
-#include <atomic>
+#include <utility>
 
 #include <expected.hpp>
-#include <gsl/span>
 
-#include "physics/body.h"
+#include "common/profile/profiler.h"
+#include "common/thread/job_pool.h"
+#include "common/timing/frame_pacer.h"
+#include "common/timing/tick_clock.h"
 #include "input/event.h"
-#include "meta/detected.h"
-#include "model/entity.h"
-#include "model/world.h"
+#include "input/recording.h"
+#include "model/simulation.h"
+
+#if !defined(AGEA_HEADLESS)
+#include <gsl/gsl_assert>
+#include <gsl/span>
 
 #include <SDL.h>
+#include "view/sdl/render.h"
 #include "view/sdl/sdl.h"
+#endif
+
 namespace hz {
     namespace {
         using seconds = std::chrono::duration<double>;
-        using milliseconds = std::chrono::duration<double, std::milli>;        
-        namespace sdl = view::sdl;
-
-        struct body_data {
-            std::atomic<physics::body2d> value;
-        };
 
-        class view_entity_t {
-        public:
-            sdl::unique_texture texture;
-            std::weak_ptr<body_data const> body;
-        };
+        inline constexpr auto dump_trace_event = std::string_view("dump_trace");
+
+        // Zones recorded so far, for chrome://tracing or Perfetto
+        void write_trace(std::string const& path) {
+#if !defined(AGEA_PROFILE)
+            std::fprintf(stderr, "Built without AGEA_PROFILE, so %s holds no zones\n", path.c_str());
+#endif
+            auto file = std::ofstream(path);
+            profile::profiler::get().write_chrome_trace(file);
+            if(!file) {
+                std::fprintf(stderr, "Unable to write trace %s\n", path.c_str());
+            }
+        }
 
-        struct game_model {
-            model::world model;
-            std::vector<std::shared_ptr<body_data>> model_body_data;
-            std::vector<view_entity_t> view_entities;
-        };
+        void report_run(char const* what, model::game_model const& game, seconds elapsed) {
+            auto const last_tick = game.checksums.get_latest_tick();
+            std::printf("%s %llu ticks in %.3f s (%.1f ticks/s), final checksum %016llx\n", what, static_cast<unsigned long long>(game.tick),
+                elapsed.count(), static_cast<double>(game.tick) / elapsed.count(), static_cast<unsigned long long>(last_tick ? *game.checksums.get(*last_tick) : 0));
+        }
 
-        class player_input {
-        public:
-            void on_update(model::entity & entity, input::event_state_t const& input) {
-                auto const check_input = [input] (auto const event_up, auto const event_down, auto & flag) {
-                    if(input.has(event_up)) {
-                        flag = true;
-                    } else if(input.has(event_down)) {
-                        flag = false;
-                    }
-                };
-                check_input(input::event_label::up_pressed, input::event_label::up_released, up_pressed);
-                check_input(input::event_label::down_pressed, input::event_label::down_released, down_pressed);
-                check_input(input::event_label::left_pressed, input::event_label::left_released, left_pressed);
-                check_input(input::event_label::right_pressed, input::event_label::right_released, right_pressed);
-
-                auto force = physics::force2d();
-                if(up_pressed) force += physics::force2d(0, input_force);
-                if(down_pressed) force += physics::force2d(0, -input_force);
-                if(left_pressed) force += physics::force2d(-input_force, 0);
-                if(right_pressed) force += physics::force2d(input_force, 0);
-                entity.body.add_force(force);
+        // Feeds the recorded event states through the simulation tick after tick, without a window or any waiting, in the
+        // scene and at the rate the recording was made with. Stops at the first tick whose checksum differs from the
+        // recorded one
+        auto replay_recording(input::event_player & player) -> tl::expected<tl::monostate, int> {
+            auto const& header = player.get_header();
+            auto game = model::init_model(static_cast<std::size_t>(header.box_count));
+            auto pool = thread::job_pool(model::default_worker_count());
+            auto const tick_duration = physics::seconds(1.0 / header.tick_rate);
+
+            auto const start = std::chrono::steady_clock::now();
+            while(auto const recorded = player.next()) {
+                auto const checksum = model::advance_tick(game, pool, recorded->events, tick_duration);
+                if(checksum != recorded->checksum) {
+                    std::fprintf(stderr, "Replay diverged at tick %llu: recorded checksum %016llx, replayed %016llx\n", static_cast<unsigned long long>(game.tick - 1),
+                        static_cast<unsigned long long>(recorded->checksum), static_cast<unsigned long long>(checksum));
+                    return tl::make_unexpected(2);
+                }
             }
+            report_run("Replayed", game, std::chrono::steady_clock::now() - start);
+            return tl::monostate();
+        }
 
-            double input_force = 20.0;
-
-        private:
-            bool up_pressed = false;
-            bool down_pressed = false;
-            bool left_pressed = false;
-            bool right_pressed = false;
-        };
+        void report_pacing(timing::frame_pacer const& pacer) {
+            auto const& stats = pacer.get_stats();
+            std::printf("Paced %llu frames: lateness mean %.1f us, stddev %.1f us, max %.1f us, %llu overruns\n", static_cast<unsigned long long>(stats.get_count()),
+                stats.get_mean_us(), stats.get_stddev_us(), stats.get_max_us(), static_cast<unsigned long long>(pacer.get_overruns()));
+        }
 
-        class gravity_component {
-        public:
-            void on_update(model::entity & entity) {
-                entity.body.add_force({0, -entity.body.weight.value * 10.0});
+        // Runs the simulation without input or video, as fast as possible or paced to one tick per tick_duration of wall time
+        auto run_headless(std::uint64_t tick_count, std::size_t box_count, physics::seconds tick_duration, bool paced) -> tl::expected<tl::monostate, int> {
+            auto game = model::init_model(box_count);
+            auto pool = thread::job_pool(model::default_worker_count());
+            auto const no_input = input::event_state_t();
+
+            auto const start = std::chrono::steady_clock::now();
+            auto pacer = timing::frame_pacer(std::chrono::duration_cast<timing::clock::duration>(tick_duration));
+            while(game.tick < tick_count) {
+                if(paced) {
+                    pacer.wait();
+                }
+                model::advance_tick(game, pool, no_input, tick_duration);
             }
-        };
-        
+            report_run("Simulated", game, std::chrono::steady_clock::now() - start);
+            if(paced) {
+                report_pacing(pacer);
+            }
+            return tl::monostate();
+        }
+
+#if !defined(AGEA_HEADLESS)
+        namespace sdl = view::sdl;
+
         auto load_texture(SDL_Renderer & renderer, const char* file_path) -> tl::expected<sdl::unique_texture, int> {
             auto const surface = sdl::unique_surface(SDL_LoadBMP(file_path));
             if(!surface) {
@@ -94,88 +120,19 @@ namespace hz {
             return texture;
         }
 
-        auto generate_white_texture(SDL_Renderer& renderer, int w, int h)-> tl::expected<sdl::unique_texture, int> {
-            auto texture = sdl::unique_texture(SDL_CreateTexture(&renderer, SDL_PIXELFORMAT_RGBA8888, SDL_TEXTUREACCESS_STATIC, w, h));
-            if(!texture) {
-                SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "Couldn't create texture: %s", SDL_GetError());
-                return tl::make_unexpected(-1);
-            }
-
-            auto const pixel_data = std::vector<uint32_t>(w*h, 0xFFFFFFFF);
-            if(auto const error = SDL_UpdateTexture(texture.get(), nullptr, std::data(pixel_data), w*sizeof(uint32_t)); error < 0) {
-                SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "Couldn't update texture: %s", SDL_GetError());
-                return tl::make_unexpected(error);
-            }
-
-            return texture;
-        }
-
-        auto init_entities(SDL_Renderer & renderer) -> tl::expected<game_model, int> {
-            auto test_entity = model::entity();
-            test_entity.components.push_back(gravity_component());
-            test_entity.components.push_back(player_input());
-
-            auto entity_data = std::make_shared<body_data>();
-
-            auto texture = generate_white_texture(renderer, 32, 32);
-            if(!texture) {
-                return tl::make_unexpected(texture.error());
-            }
-            auto view_entities = std::vector<view_entity_t>(1);
-            view_entities[0] = {std::move(texture).value(), entity_data};
-
-            return game_model{model::world{}.add_entity(std::move(test_entity)), {entity_data}, std::move(view_entities)};
-        }
-
-        void update_entities(range::contiguous_view<model::entity> model_entities, range::contiguous_view<std::shared_ptr<body_data>> body_data, input::event_state_t const& input, physics::seconds dt) {
-            for(auto & entity : model_entities) {
-                for(auto & component : entity.components) {
-                    component.on_update(entity, input, dt);
+        // One view entity per body of the model, the player and the floor as well as the falling boxes
+        auto init_view_entities(SDL_Renderer & renderer, model::game_model const& game) -> tl::expected<std::vector<sdl::view_entity_t>, int> {
+            auto const body_count = game.model.get_bodies().size();
+            auto view_entities = std::vector<sdl::view_entity_t>();
+            view_entities.reserve(body_count);
+            for(std::size_t body_index = 0; body_index < body_count; ++body_index) {
+                auto texture = sdl::generate_white_texture(renderer, 32, 32);
+                if(!texture) {
+                    return tl::make_unexpected(texture.error());
                 }
-                entity.body = physics::integrate(entity.body, dt);
-                entity.body.acceleration = physics::acceleration2d();
+                view_entities.push_back({std::move(texture).value(), body_index});
             }
-
-            for(ptrdiff_t i = 0; i < model_entities.size(); ++i) {
-                body_data[i]->value.store(model_entities[i].body);
-            }
-        }
-
-        auto constexpr window_x = 320;
-        auto constexpr window_y = 240;
-        auto constexpr camera_world_x = 100.0;
-        auto constexpr camera_world_y = 75.0;
-
-        auto integer_floor(double d) -> int {
-            return static_cast<int>(d);
-        }
-
-        void render_entities(gsl::span<view_entity_t> view_entities, SDL_Renderer & renderer) {
-            SDL_SetRenderDrawColor(&renderer, 0x00, 0x00, 0x00, 0x00);
-            SDL_RenderClear(&renderer);           
-
-            for(auto const& entity : view_entities) {
-                auto const body_data = entity.body.lock();
-                if(!body_data) { continue; }
-                auto const body = body_data->value.load();
-
-                auto const center_x = window_x / 2;
-                auto const center_y = window_y / 2;
-                auto const dest_target_x = center_x + integer_floor(body.position.value.x / camera_world_x * window_x);
-                auto const dest_target_y = center_y + integer_floor(-body.position.value.y / camera_world_y * window_y);
-
-                auto const render_width = integer_floor(body.dimension.x / camera_world_x * window_x);
-                auto const render_height = integer_floor(body.dimension.y / camera_world_y * window_y);
-
-                auto const dest_target = SDL_Rect{
-                    dest_target_x - render_width / 2,
-                    dest_target_y - render_height / 2,
-                    render_width,
-                    render_height,
-                };
-                SDL_RenderCopy(&renderer, entity.texture.get(), nullptr, &dest_target);
-            }
-            SDL_RenderPresent(&renderer);
+            return view_entities;
         }
 
         auto get_player_input(SDL_Event& e) -> std::optional<input::event_t> {
@@ -206,6 +163,9 @@ namespace hz {
                 if(event.type == SDL_QUIT || event.type == SDL_KEYUP && event.key.keysym.sym == SDLK_ESCAPE) {
                     event_state.push(input::event_label::exit);
                 }
+                if(event.type == SDL_KEYUP && event.key.keysym.sym == SDLK_F12) {
+                    event_state.push(input::event_t(dump_trace_event));
+                }
 
                 if(auto const player_input = get_player_input(event)) {
                     event_state.push(*player_input);
@@ -215,43 +175,124 @@ namespace hz {
             return event_state;
         }
 
-        void do_game_loop(SDL_Renderer& renderer, game_model & model) {
-            auto constexpr frame_duration = milliseconds(1.0 / 60.0);
-            auto frame_buffer = milliseconds();
+        struct loop_settings {
+            std::uint32_t tick_rate;
+            // Records the event state of every tick, for replay_recording
+            input::event_recorder * recorder = nullptr;
+            // F12 writes the profiler's zones there
+            std::optional<std::string> trace_path;
+        };
+
+        // Frames are paced to the tick rate. After a stall, at most this many ticks run in one frame and the rest of the
+        // backlog is dropped, so that a frame too slow to keep up does not make the next one slower still
+        auto constexpr max_catch_up_ticks = 5;
+
+        // While the world is at rest and no key is held, the loop blocks on the event queue instead of ticking and
+        // redrawing an unchanged frame. Waits time out now and then so that a stuck queue cannot hang the loop for good
+        auto constexpr idle_wait_timeout_ms = 250;
+
+        // Returns the time spent blocked, once an event is queued. The event is left on the queue for get_events
+        auto wait_while_idle() -> timing::clock::duration {
+            HZ_PROFILE_ZONE("idle");
+            auto const start = timing::clock::now();
+            while(SDL_WaitEventTimeout(nullptr, idle_wait_timeout_ms) == 0) {
+            }
+            return timing::clock::now() - start;
+        }
+
+        void do_game_loop(SDL_Renderer& renderer, model::game_model & game, gsl::span<sdl::view_entity_t> view_entities, thread::job_pool & pool, loop_settings const& settings) {
+            auto ticks = timing::tick_clock(settings.tick_rate);
+            auto pacer = timing::frame_pacer(ticks.get_period());
+            auto keys = input::held_keys();
+            // Events of frames that ran no tick are kept for the next tick, so that none are lost
+            auto pending_events = input::event_state_t();
+            auto idle = false;
+            // The first frames come before any tick is due, and draw the scene as it starts
+            model::store_previous_positions(game);
+            model::publish_snapshot(game);
+            auto frame_start = timing::clock::now();
             while(true) {
-                auto const frame_start = std::chrono::steady_clock::now();
+                if(idle) {
+                    // The idle time counts as dropped ticks, none of which would have changed the world
+                    ticks.advance(wait_while_idle());
+                    ticks.limit_backlog(0);
+                    pacer.reset();
+                    frame_start = timing::clock::now();
+                }
 
-                auto const event_state = get_events();
+                HZ_PROFILE_ZONE("frame");
+
+                auto const event_state = [] {
+                    HZ_PROFILE_ZONE("get_events");
+                    return get_events();
+                }();
                 if(event_state.has(input::event_label::exit)) {
                     break;
                 }
+                if(settings.trace_path && event_state.has(dump_trace_event)) {
+                    write_trace(*settings.trace_path);
+                }
+                keys.update(event_state);
+                for(auto const& e : event_state) {
+                    pending_events.push(e);
+                }
 
-                while(frame_buffer > frame_duration) {
-                    update_entities(model.model.get_entities(), model.model_body_data, event_state, frame_duration);
-                    frame_buffer -= frame_duration;
+                auto const was_at_rest = model::is_at_rest(game);
+                {
+                    HZ_PROFILE_ZONE("simulate");
+                    ticks.limit_backlog(max_catch_up_ticks);
+                    auto const simulated = ticks.is_tick_due();
+                    while(ticks.is_tick_due()) {
+                        ticks.take_tick();
+                        if(!ticks.is_tick_due()) {
+                            model::store_previous_positions(game);
+                        }
+                        auto const checksum = model::advance_tick(game, pool, pending_events, ticks.get_tick_duration());
+                        if(settings.recorder) {
+                            settings.recorder->record(pending_events, checksum);
+                        }
+                        pending_events = input::event_state_t();
+                    }
+                    if(simulated) {
+                        model::publish_snapshot(game);
+                    }
                 }
 
-                render_entities(model.view_entities, renderer);
+                {
+                    HZ_PROFILE_ZONE("render_entities");
+                    auto const& snapshot = game.snapshots->read();
+                    Expects(snapshot.positions.size() == static_cast<std::size_t>(view_entities.size()));
+                    sdl::render_entities(view_entities, snapshot, ticks.get_alpha(), renderer);
+                }
 
-                auto const frame_complete = std::chrono::steady_clock::now();
-                auto const frame_completion_duration = frame_complete - frame_start;
-                if(frame_completion_duration < frame_duration) {
-                    std::this_thread::sleep_for(frame_duration - frame_completion_duration);
+                {
+                    HZ_PROFILE_ZONE("sleep");
+                    pacer.wait();
                 }
-                auto const frame_end = std::chrono::steady_clock::now();
-                frame_buffer += frame_end - frame_start;
+                auto const frame_end = timing::clock::now();
+                ticks.advance(frame_end - frame_start);
+                frame_start = frame_end;
+
+                // Idle once a whole frame passed at rest, so the frame just drawn shows where the bodies came to rest
+                idle = was_at_rest && model::is_at_rest(game) && !keys.is_any_held() && pending_events.size() == 0;
             }
 
+            report_pacing(pacer);
+            std::printf("Simulated %llu ticks, dropped %llu while behind or idle\n", static_cast<unsigned long long>(ticks.get_tick()), static_cast<unsigned long long>(ticks.get_dropped_ticks()));
         }
 
-        auto game_loop(SDL_Renderer& renderer) -> tl::expected<tl::monostate, int> {
-            auto game_result = init_entities(renderer);
-            return game_result.map([&renderer] (game_model& model) { do_game_loop(renderer, model); });
+        auto game_loop(SDL_Renderer& renderer, std::size_t box_count, loop_settings const& settings) -> tl::expected<tl::monostate, int> {
+            auto game = model::init_model(box_count);
+            auto view_result = init_view_entities(renderer, game);
+            auto pool = thread::job_pool(model::default_worker_count());
+            return view_result.map([&] (std::vector<sdl::view_entity_t> & view_entities) { do_game_loop(renderer, game, view_entities, pool, settings); });
         }
+#endif
     }
 }
 
 namespace {
+#if !defined(AGEA_HEADLESS)
     namespace sdl = hz::sdl;
 
     auto sdl_init() -> tl::expected<tl::monostate,int> {
@@ -277,7 +318,7 @@ namespace {
     auto make_window_and_renderer() -> tl::expected<std::pair<sdl::unique_window, sdl::unique_renderer>, int> {
         SDL_Window* window;
         SDL_Renderer* renderer;
-        if(auto const error = SDL_CreateWindowAndRenderer(hz::window_x, hz::window_y, SDL_WINDOW_RESIZABLE, &window, &renderer)
+        if(auto const error = SDL_CreateWindowAndRenderer(sdl::window_x, sdl::window_y, SDL_WINDOW_RESIZABLE, &window, &renderer)
            ; error < 0) {
             SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "Couldn't create surface from image: %s", SDL_GetError());
             return tl::make_unexpected(error);
@@ -285,26 +326,145 @@ namespace {
 
         return std::make_pair(sdl::unique_window(window), sdl::unique_renderer(renderer));
     }
-}
 
+    auto run_windowed(std::size_t box_count, std::uint32_t tick_rate, std::optional<std::string> const& record_path, std::optional<std::string> const& trace_path) -> int {
+        auto record_file = std::ofstream();
+        auto recorder = std::optional<hz::input::event_recorder>();
+        if(record_path) {
+            record_file.open(*record_path, std::ios::binary);
+            if(!record_file) {
+                std::fprintf(stderr, "Unable to write recording %s\n", record_path->c_str());
+                return 1;
+            }
+            recorder.emplace(record_file, hz::input::recording::header{box_count, tick_rate});
+        }
 
-auto main(int argc, char* argv[]) -> int {
-    (void)argc, (void)argv;
-    if(auto const result = sdl_init(); !result) {
-        return result.error();
+        if(auto const result = sdl_init(); !result) {
+            return result.error();
+        }
+
+        if(auto const result = sdl_sub_init(); !result) {
+            return result.error();
+        }
+
+        auto result = make_window_and_renderer();
+        if(!result) {
+            return result.error();
+        }
+        auto const[window, renderer] = std::move(result).value();
+        (void)window;
+
+        auto const game_result = hz::game_loop(*renderer.get(), box_count, {tick_rate, recorder ? &*recorder : nullptr, trace_path});
+        return game_result ? 0 : game_result.error();
+    }
+#endif
+
+    struct launch_options {
+        std::optional<std::string> record_path;
+        std::optional<std::string> replay_path;
+        std::optional<std::string> trace_path;
+#if defined(AGEA_HEADLESS)
+        bool headless = true;
+#else
+        bool headless = false;
+#endif
+        bool paced = false;
+        std::uint64_t tick_count = 600;
+        std::size_t box_count = 0;
+        std::uint32_t tick_rate = hz::model::default_tick_rate;
+
+        auto get_tick_duration() const -> hz::physics::seconds {
+            return hz::physics::seconds(1.0 / tick_rate);
+        }
+    };
+
+    template<typename T>
+    auto parse_number(std::string_view text, T & value) -> bool {
+        auto const end = text.data() + text.size();
+        auto const [last, error] = std::from_chars(text.data(), end, value);
+        return error == std::errc() && last == end;
+    }
+
+    auto parse_options(int argc, char* argv[]) -> tl::expected<launch_options, int> {
+        auto options = launch_options();
+        auto valid = true;
+        for(int i = 1; i < argc && valid; ++i) {
+            auto const arg = std::string_view(argv[i]);
+            auto const has_value = i + 1 < argc;
+            if(arg == "--headless") {
+                options.headless = true;
+            } else if(arg == "--paced") {
+                options.paced = true;
+            } else if(arg == "--record" && has_value) {
+                options.record_path = argv[++i];
+            } else if(arg == "--replay" && has_value) {
+                options.replay_path = argv[++i];
+            } else if(arg == "--trace" && has_value) {
+                options.trace_path = argv[++i];
+            } else if(arg == "--ticks" && has_value) {
+                valid = parse_number(argv[++i], options.tick_count);
+            } else if(arg == "--bodies" && has_value) {
+                valid = parse_number(argv[++i], options.box_count);
+            } else if(arg == "--tick-rate" && has_value) {
+                valid = parse_number(argv[++i], options.tick_rate) && options.tick_rate > 0;
+            } else {
+                valid = false;
+            }
+        }
+        if(!valid) {
+            std::fprintf(stderr,
+                "Usage: %s [--headless [--paced]] [--ticks <count>] [--bodies <count>] [--tick-rate <hz>] [--record <file> | --replay <file>] [--trace <file>]\n"
+                "  --headless   simulate without a window, as fast as possible\n"
+                "  --paced      keep a headless run to one tick per tick period of wall time, and report the jitter\n"
+                "  --ticks      ticks a headless run lasts, 600 by default\n"
+                "  --bodies     falling boxes added to the scene\n"
+                "  --tick-rate  simulation ticks per second, 60 by default\n"
+                "  --record     save the input of a windowed session\n"
+                "  --replay     run a saved session headless and as fast as possible, with the bodies and tick rate it was\n"
+                "               recorded with, and report the first tick that diverged from it\n"
+                "  --trace      write profiler zones as a Chrome trace on exit, and on F12 in a window\n",
+                argv[0]);
+            return tl::make_unexpected(1);
+        }
+        return options;
     }
 
-    if(auto const result = sdl_sub_init(); !result) {
-        return result.error();
+    auto replay(std::string const& path) -> int {
+        auto file = std::ifstream(path, std::ios::binary);
+        auto player = hz::input::event_player(file);
+        if(!player.good()) {
+            std::fprintf(stderr, "Unable to read recording %s\n", path.c_str());
+            return 1;
+        }
+        auto const result = hz::replay_recording(player);
+        return result ? 0 : result.error();
     }
+}
+
 
-    auto result = make_window_and_renderer();
-    if(!result) {
-        return result.error();
+auto main(int argc, char* argv[]) -> int {
+    auto options = parse_options(argc, argv);
+    if(!options) {
+        return options.error();
     }
-    auto const[window, renderer] = std::move(result).value();
-    (void)window;
 
-    auto const game_result = hz::game_loop(*renderer.get());
-    return game_result ? 0 : game_result.error();
-}
\ No newline at end of file
+    auto const result = [&options] {
+        if(options->replay_path) {
+            return replay(*options->replay_path);
+        }
+        if(options->headless) {
+            auto const result = hz::run_headless(options->tick_count, options->box_count, options->get_tick_duration(), options->paced);
+            return result ? 0 : result.error();
+        }
+#if defined(AGEA_HEADLESS)
+        return 0;
+#else
+        return run_windowed(options->box_count, options->tick_rate, options->record_path, options->trace_path);
+#endif
+    }();
+
+    if(options->trace_path) {
+        hz::write_trace(*options->trace_path);
+    }
+    return result;
+}
@@ -0,0 +1,87 @@
+#if _MSC_VER
+#define _SILENCE_CXX17_UNCAUGHT_EXCEPTION_DEPRECATION_WARNING
+#endif
+
+#include <catch.hpp>
+
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+#include <common/hash/state_hasher.h>
+
+TEST_CASE("State hasher", "[hash]") {
+    using hz::hash::state_hasher;
+
+    auto words = std::vector<std::uint64_t>(1001);
+    for(std::size_t i = 0; i < words.size(); ++i) {
+        words[i] = i * 0x9E3779B97F4A7C15ull;
+    }
+    auto const digest = [] (auto const& data, std::uint64_t seed = 0) {
+        auto hasher = state_hasher(seed);
+        hasher.update(data.data(), data.size() * sizeof(data[0]));
+        return hasher.digest();
+    };
+    auto const whole = digest(words);
+
+    SECTION("Deterministic") {
+        REQUIRE(digest(words) == whole);
+        REQUIRE(digest(words, 1) != whole);
+        // The same in every build, whether it takes the scalar, SSE2 or AVX2 path
+        REQUIRE(whole == 0x9d106cb0a3f8832dull);
+    }
+
+    SECTION("Split updates match the striped path") {
+        // A word at a time only ever takes the scalar path
+        auto scalar = state_hasher();
+        for(auto const word : words) {
+            scalar.update_value(word);
+        }
+        REQUIRE(scalar.digest() == whole);
+
+        // Updates ending mid stripe
+        auto split = state_hasher();
+        split.update(words.data(), 3 * sizeof(std::uint64_t));
+        split.update(hz::range::contiguous_view<std::uint64_t const>(words).subspan(3, 500));
+        split.update(words.data() + 503, (words.size() - 503) * sizeof(std::uint64_t));
+        REQUIRE(split.digest() == whole);
+    }
+
+    SECTION("Sensitive to every word") {
+        for(auto const i : {std::size_t(0), std::size_t(1), std::size_t(2), std::size_t(3), std::size_t(500), words.size() - 1}) {
+            auto changed = words;
+            changed[i] ^= 1;
+            REQUIRE(digest(changed) != whole);
+        }
+
+        auto swapped = words;
+        std::swap(swapped[4], swapped[8]);
+        REQUIRE(digest(swapped) != whole);
+    }
+
+    SECTION("Length") {
+        REQUIRE(digest(std::vector<unsigned char>(13, 0)) != digest(std::vector<unsigned char>(12, 0)));
+        REQUIRE(digest(std::vector<std::uint64_t>(5, 0)) != digest(std::vector<std::uint64_t>(4, 0)));
+    }
+}
+
+TEST_CASE("Checksum stream", "[hash]") {
+    auto stream = hz::hash::checksum_stream(4);
+    REQUIRE(!stream.get_latest_tick());
+    REQUIRE(!stream.get(0));
+
+    for(std::uint64_t tick = 0; tick < 6; ++tick) {
+        stream.push(tick, tick * 10);
+    }
+    REQUIRE(stream.get_latest_tick() == std::uint64_t(5));
+    REQUIRE(!stream.get(1));
+    REQUIRE(stream.get(2) == std::uint64_t(20));
+    REQUIRE(stream.get(5) == std::uint64_t(50));
+    REQUIRE(!stream.get(6));
+
+    auto latest_only = hz::hash::checksum_stream(1);
+    latest_only.push(0, 1);
+    latest_only.push(1, 2);
+    REQUIRE(!latest_only.get(0));
+    REQUIRE(latest_only.get(1) == std::uint64_t(2));
+}
@@ -0,0 +1,91 @@
+#if _MSC_VER
+#define _SILENCE_CXX17_UNCAUGHT_EXCEPTION_DEPRECATION_WARNING
+#endif 
+
+#include <catch.hpp>
+
+#include <set>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <common/profile/profiler.h>
+
+TEST_CASE("Profiler", "[profile]") {
+    using hz::profile::profiler;
+    using hz::profile::scoped_zone;
+    using hz::profile::zone_record;
+
+    SECTION("Nested zones") {
+        auto p = profiler(16);
+        {
+            auto const outer = scoped_zone("outer", p);
+            auto const inner = scoped_zone("inner", p);
+        }
+
+        auto zones = std::vector<zone_record>();
+        p.get_thread_buffer().for_each([&zones] (zone_record const& zone) { zones.push_back(zone); });
+        REQUIRE(zones.size() == 2);
+        REQUIRE(std::string(zones[0].name) == "inner");
+        REQUIRE(std::string(zones[1].name) == "outer");
+        REQUIRE(zones[1].begin_ns <= zones[0].begin_ns);
+        REQUIRE(zones[0].end_ns <= zones[1].end_ns);
+    }
+
+    SECTION("Ring buffer keeps the newest zones") {
+        auto p = profiler(4);
+        auto & buffer = p.get_thread_buffer();
+        for(std::int64_t i = 0; i < 10; ++i) {
+            buffer.push({"zone", i, i + 1});
+        }
+
+        auto begins = std::vector<std::int64_t>();
+        buffer.for_each([&begins] (zone_record const& zone) { begins.push_back(zone.begin_ns); });
+        REQUIRE(begins == std::vector<std::int64_t>{6, 7, 8, 9});
+
+        p.clear();
+        auto count = 0;
+        buffer.for_each([&count] (zone_record const&) { ++count; });
+        REQUIRE(count == 0);
+    }
+
+    SECTION("One buffer per thread") {
+        auto p = profiler(16);
+        auto const record = [&p] {
+            auto const zone = scoped_zone("worker", p);
+        };
+        auto first = std::thread(record);
+        auto second = std::thread(record);
+        first.join();
+        second.join();
+        record();
+        record();
+
+        auto out = std::ostringstream();
+        p.write_chrome_trace(out);
+        auto const trace = out.str();
+
+        auto tids = std::set<std::string>();
+        auto zone_count = 0;
+        for(auto at = trace.find("\"tid\":"); at != std::string::npos; at = trace.find("\"tid\":", at + 1)) {
+            tids.insert(trace.substr(at + 6, trace.find(',', at) - at - 6));
+            ++zone_count;
+        }
+        REQUIRE(zone_count == 4);
+        REQUIRE(tids.size() == 3);
+    }
+
+    SECTION("Chrome trace") {
+        auto p = profiler(16);
+        p.get_thread_buffer().push({"say \"hi\"", 0, 1500});
+
+        auto out = std::ostringstream();
+        p.write_chrome_trace(out);
+        auto const trace = out.str();
+        REQUIRE(trace.find("{\"traceEvents\":[") == 0);
+        REQUIRE(trace.find("\"name\":\"say \\\"hi\\\"\"") != std::string::npos);
+        REQUIRE(trace.find("\"ph\":\"X\"") != std::string::npos);
+        REQUIRE(trace.find("\"dur\":1.500") != std::string::npos);
+    }
+}
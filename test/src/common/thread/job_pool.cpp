@@ -0,0 +1,31 @@
+#if _MSC_VER
+#define _SILENCE_CXX17_UNCAUGHT_EXCEPTION_DEPRECATION_WARNING
+#endif 
+
+#include <catch.hpp>
+
+#include <numeric>
+#include <vector>
+
+#include <common/thread/job_pool.h>
+
+TEST_CASE("Job pool", "[thread]") {
+    for(std::size_t worker_count : {0, 1, 3}) {
+        auto pool = hz::thread::job_pool(worker_count);
+        REQUIRE(pool.get_worker_count() == worker_count);
+
+        auto values = std::vector<int>(10007, 0);
+        for(int pass = 0; pass < 20; ++pass) {
+            pool.parallel_for(0, values.size(), 64, [&values] (std::ptrdiff_t begin, std::ptrdiff_t end) {
+                for(auto i = begin; i < end; ++i) {
+                    values[i] += 1;
+                }
+            });
+        }
+        REQUIRE(std::accumulate(values.begin(), values.end(), 0) == 20 * 10007);
+
+        auto called = false;
+        pool.parallel_for(5, 5, 64, [&called] (std::ptrdiff_t, std::ptrdiff_t) { called = true; });
+        REQUIRE(!called);
+    }
+}
@@ -0,0 +1,59 @@
+#if _MSC_VER
+#define _SILENCE_CXX17_UNCAUGHT_EXCEPTION_DEPRECATION_WARNING
+#endif 
+
+#include <catch.hpp>
+
+#include <thread>
+
+#include <common/thread/triple_buffer.h>
+
+TEST_CASE("Triple buffer", "[thread]") {
+    struct frame {
+        long first = 0;
+        long second = 0;
+    };
+
+    SECTION("Single thread") {
+        auto buffer = hz::thread::triple_buffer<frame>();
+        REQUIRE(!buffer.has_update());
+        REQUIRE(buffer.read().first == 0);
+
+        buffer.get_write_buffer() = frame{1, 1};
+        buffer.publish();
+        buffer.get_write_buffer() = frame{2, 2};
+        buffer.publish();
+        REQUIRE(buffer.has_update());
+        REQUIRE(buffer.read().first == 2);
+        REQUIRE(!buffer.has_update());
+        REQUIRE(buffer.read().first == 2);
+    }
+
+    SECTION("Concurrent") {
+        auto buffer = hz::thread::triple_buffer<frame>();
+        auto constexpr frame_count = 100000L;
+
+        auto writer = std::thread([&buffer] {
+            for(auto i = 1L; i <= frame_count; ++i) {
+                auto & f = buffer.get_write_buffer();
+                f.first = i;
+                f.second = i;
+                buffer.publish();
+            }
+        });
+
+        auto last = 0L;
+        auto consistent = true;
+        auto monotonic = true;
+        while(last < frame_count) {
+            auto const& f = buffer.read();
+            consistent = consistent && f.first == f.second;
+            monotonic = monotonic && f.first >= last;
+            last = f.first;
+        }
+        writer.join();
+
+        REQUIRE(consistent);
+        REQUIRE(monotonic);
+    }
+}
@@ -0,0 +1,63 @@
+#if _MSC_VER
+#define _SILENCE_CXX17_UNCAUGHT_EXCEPTION_DEPRECATION_WARNING
+#endif
+
+#include <catch.hpp>
+
+#include <chrono>
+#include <thread>
+
+#include <common/timing/frame_pacer.h>
+
+TEST_CASE("Frame pacer", "[timing]") {
+    using hz::timing::clock;
+    using hz::timing::frame_pacer;
+    using hz::timing::jitter_stats;
+    using namespace std::chrono_literals;
+
+    SECTION("Jitter statistics") {
+        auto stats = jitter_stats();
+        REQUIRE(stats.get_count() == 0);
+        REQUIRE(stats.get_mean_us() == 0.0);
+        REQUIRE(stats.get_stddev_us() == 0.0);
+
+        stats.add(10us);
+        stats.add(30us);
+        REQUIRE(stats.get_count() == 2);
+        REQUIRE(stats.get_mean_us() == Approx(20.0));
+        REQUIRE(stats.get_stddev_us() == Approx(10.0));
+        REQUIRE(stats.get_max_us() == Approx(30.0));
+    }
+
+    SECTION("Frames follow the deadline grid") {
+        auto constexpr period = 5ms;
+        auto constexpr frames = 20;
+        auto pacer = frame_pacer(period);
+        auto const start = clock::now();
+        for(int i = 0; i < frames; ++i) {
+            pacer.wait();
+        }
+        auto const elapsed = clock::now() - start;
+
+        // Deadlines do not drift with each frame's lateness, so the run never finishes early and only its last frame's
+        // lateness adds up
+        REQUIRE(elapsed >= period * frames);
+        REQUIRE(elapsed < period * frames + 50ms);
+        REQUIRE(pacer.get_stats().get_count() == frames);
+    }
+
+    SECTION("An overrun restarts the grid") {
+        auto constexpr period = 5ms;
+        auto pacer = frame_pacer(period);
+        pacer.wait();
+        std::this_thread::sleep_for(4 * period);
+        pacer.wait();
+        REQUIRE(pacer.get_overruns() == 1);
+
+        // The next frame waits a whole period instead of returning at once to catch up
+        auto const start = clock::now();
+        pacer.wait();
+        REQUIRE(clock::now() - start >= period - 1ms);
+        REQUIRE(pacer.get_overruns() == 1);
+    }
+}
@@ -0,0 +1,69 @@
+#if _MSC_VER
+#define _SILENCE_CXX17_UNCAUGHT_EXCEPTION_DEPRECATION_WARNING
+#endif
+
+#include <catch.hpp>
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+
+#include <common/timing/tick_clock.h>
+
+TEST_CASE("Tick clock", "[timing]") {
+    using hz::timing::tick_clock;
+    using namespace std::chrono_literals;
+
+    auto const take_due = [] (tick_clock & clock) {
+        auto taken = std::uint64_t(0);
+        while(clock.is_tick_due()) {
+            clock.take_tick();
+            ++taken;
+        }
+        return taken;
+    };
+
+    SECTION("A day of uneven frames") {
+        // Frame times that are no multiple of the 60 Hz period, which is no whole number of nanoseconds either
+        auto clock = tick_clock(60);
+        auto elapsed = std::chrono::nanoseconds();
+        auto frame = std::uint64_t(0);
+        while(elapsed < 24h) {
+            auto const frame_time = std::chrono::nanoseconds(16'666'667 + static_cast<std::int64_t>(frame % 7) * 1'000'003 - 3'000'000);
+            auto const step = std::min<std::chrono::nanoseconds>(frame_time, 24h - elapsed);
+            clock.advance(step);
+            elapsed += step;
+            take_due(clock);
+            ++frame;
+        }
+        REQUIRE(clock.get_tick() == 24 * 60 * 60 * 60);
+        REQUIRE(clock.get_alpha() == 0.0);
+    }
+
+    SECTION("Ticks fall on exact boundaries") {
+        auto clock = tick_clock(3);
+        clock.advance(333'333'333ns);
+        REQUIRE(!clock.is_tick_due());
+        clock.advance(1ns);
+        REQUIRE(clock.take_tick() == 0);
+        REQUIRE(!clock.is_tick_due());
+        clock.advance(666'666'666ns);
+        REQUIRE(take_due(clock) == 2);
+        REQUIRE(clock.get_alpha() == 0.0);
+        REQUIRE(clock.get_period() == 333'333'333ns);
+        REQUIRE(clock.get_tick_duration().count() == Approx(1.0 / 3.0));
+    }
+
+    SECTION("Backlog limit") {
+        auto clock = tick_clock(100);
+        clock.advance(105ms);
+        clock.limit_backlog(3);
+        REQUIRE(clock.get_dropped_ticks() == 7);
+        REQUIRE(clock.get_alpha() == Approx(3.5));
+        REQUIRE(take_due(clock) == 3);
+        REQUIRE(clock.get_alpha() == Approx(0.5));
+
+        clock.limit_backlog(3);
+        REQUIRE(clock.get_dropped_ticks() == 7);
+    }
+}
@@ -0,0 +1,33 @@
+#if _MSC_VER
+#define _SILENCE_CXX17_UNCAUGHT_EXCEPTION_DEPRECATION_WARNING
+#endif 
+
+#include <catch.hpp>
+
+#include <input/event.h>
+
+TEST_CASE("Held keys", "[input]") {
+    using hz::input::event_label;
+    using hz::input::event_state_t;
+
+    auto keys = hz::input::held_keys();
+    REQUIRE(!keys.is_any_held());
+
+    keys.update(event_state_t{event_label::up_pressed, event_label::left_pressed});
+    REQUIRE(keys.is_any_held());
+
+    REQUIRE(keys.is_up_held());
+    REQUIRE(keys.is_left_held());
+    REQUIRE(!keys.is_down_held());
+    REQUIRE(!keys.is_right_held());
+
+    keys.update(event_state_t{event_label::up_released});
+    REQUIRE(keys.is_any_held());
+    REQUIRE(!keys.is_up_held());
+
+    keys.update(event_state_t());
+    REQUIRE(keys.is_any_held());
+
+    keys.update(event_state_t{event_label::left_released, event_label::exit});
+    REQUIRE(!keys.is_any_held());
+}
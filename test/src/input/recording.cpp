@@ -0,0 +1,68 @@
+#if _MSC_VER
+#define _SILENCE_CXX17_UNCAUGHT_EXCEPTION_DEPRECATION_WARNING
+#endif 
+
+#include <catch.hpp>
+
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include <input/recording.h>
+
+TEST_CASE("Input recording", "[input]") {
+    using hz::input::event_label;
+    using hz::input::event_state_t;
+    using hz::input::event_t;
+
+    auto const ticks = std::vector<event_state_t>{
+        event_state_t{event_label::up_pressed, event_label::left_pressed},
+        event_state_t(),
+        event_state_t{event_t("jump"), event_label::up_released, event_t("")},
+    };
+
+    auto stream = std::stringstream(std::ios::in | std::ios::out | std::ios::binary);
+    auto recorder = hz::input::event_recorder(stream, {5000000000ull, 60});
+    for(std::size_t i = 0; i < ticks.size(); ++i) {
+        recorder.record(ticks[i], 0x0123456789ABCDEFull + i);
+    }
+    REQUIRE(recorder.good());
+    auto const recording = stream.str();
+
+    SECTION("Round trip") {
+        auto in = std::istringstream(recording, std::ios::binary);
+        auto player = hz::input::event_player(in);
+        REQUIRE(player.good());
+        REQUIRE(player.get_header().box_count == 5000000000ull);
+        REQUIRE(player.get_header().tick_rate == 60);
+        for(std::size_t i = 0; i < ticks.size(); ++i) {
+            auto const replayed = player.next();
+            REQUIRE(replayed);
+            REQUIRE(std::equal(replayed->events.begin(), replayed->events.end(), ticks[i].begin(), ticks[i].end()));
+            REQUIRE(replayed->checksum == 0x0123456789ABCDEFull + i);
+        }
+        REQUIRE(!player.next());
+        REQUIRE(!player.good());
+    }
+
+    SECTION("Truncated") {
+        auto in = std::istringstream(recording.substr(0, recording.size() - 2), std::ios::binary);
+        auto player = hz::input::event_player(in);
+        REQUIRE(player.next());
+        REQUIRE(player.next());
+        REQUIRE(!player.next());
+    }
+
+    SECTION("Not a recording") {
+        auto in = std::istringstream("HZIX\x02\0\0\0", std::ios::binary);
+        auto player = hz::input::event_player(in);
+        REQUIRE(!player.good());
+        REQUIRE(!player.next());
+    }
+
+    SECTION("Older version") {
+        auto in = std::istringstream(std::string("HZIR\x01\0\0\0\0\0\0\0", 12), std::ios::binary);
+        auto player = hz::input::event_player(in);
+        REQUIRE(!player.good());
+    }
+}
@@ -0,0 +1,76 @@
+#if _MSC_VER
+#define _SILENCE_CXX17_UNCAUGHT_EXCEPTION_DEPRECATION_WARNING
+#endif 
+
+#include <catch.hpp>
+
+#include <cstdint>
+#include <limits>
+#include <random>
+
+#include <math/fixed.h>
+#include <math/vector.h>
+
+TEST_CASE("Fixed point arithmetic", "[math]") {
+    using hz::math::fixed;
+
+    static_assert(fixed(3) * fixed(0.5) == fixed(1.5));
+    static_assert(fixed(3) / fixed(4) == fixed(0.75));
+    static_assert(fixed(-3) / fixed(2) == fixed(-1.5));
+    static_assert(fixed(1) - fixed(0.25) > fixed(0.5));
+
+    REQUIRE(fixed(2.5).to_double() == 2.5);
+    REQUIRE(fixed(-2.5).get_raw() == -(std::int64_t(5) << 31));
+    REQUIRE(fixed(7) + fixed(-3) == fixed(4));
+    REQUIRE(-fixed(7) == fixed(-7));
+    // One raw unit times a half is below resolution: multiplication rounds down, division towards zero
+    REQUIRE(fixed::from_raw(1) * fixed(0.5) == fixed::from_raw(0));
+    REQUIRE(fixed::from_raw(-1) * fixed(0.5) == fixed::from_raw(-1));
+    REQUIRE(fixed::from_raw(-1) / fixed(2) == fixed::from_raw(0));
+
+    auto accumulated = fixed(0);
+    for(int i = 0; i < 1000; ++i) {
+        accumulated += fixed(1) / fixed(1000);
+    }
+    REQUIRE(accumulated.to_double() == Approx(1.0).margin(1e-6));
+
+    SECTION("From double") {
+        // 0.1 lies between two raw steps, and rounds to the nearer one whatever its sign
+        REQUIRE(fixed(0.1).get_raw() == 429496730);
+        REQUIRE(fixed(-0.1).get_raw() == -429496730);
+        REQUIRE(fixed(0.75 / fixed::one).get_raw() == 1);
+        REQUIRE(fixed(-0.75 / fixed::one).get_raw() == -1);
+        REQUIRE(fixed(0.25 / fixed::one).get_raw() == 0);
+        REQUIRE(fixed(0.5 / fixed::one).get_raw() == 1);
+        REQUIRE(fixed(-0.5 / fixed::one).get_raw() == -1);
+
+        REQUIRE(fixed(1e300).get_raw() == INT64_MAX);
+        REQUIRE(fixed(-1e300).get_raw() == INT64_MIN);
+        REQUIRE(fixed(std::numeric_limits<double>::infinity()).get_raw() == INT64_MAX);
+        REQUIRE(fixed(-std::numeric_limits<double>::infinity()).get_raw() == INT64_MIN);
+        REQUIRE(fixed(std::numeric_limits<double>::quiet_NaN()).get_raw() == 0);
+        // The largest whole number converts exactly, the next one is out of range
+        REQUIRE(fixed(2147483647.0).get_raw() == std::int64_t(2147483647) << 32);
+        REQUIRE(fixed(2147483648.0).get_raw() == INT64_MAX);
+    }
+
+    SECTION("Vectors") {
+        using vector2x = hz::math::basic_vector2d<fixed>;
+        auto const v = vector2x{fixed(1.5), fixed(-2)};
+        REQUIRE(v * fixed(2) == vector2x{fixed(3), fixed(-4)});
+        REQUIRE(2 * v == vector2x{fixed(3), fixed(-4)});
+        REQUIRE(v / 2 == vector2x{fixed(0.75), fixed(-1)});
+        REQUIRE(hz::math::scalar_product(v, v) == fixed(6.25));
+    }
+
+    SECTION("Portable fallback matches the native 128 bit path") {
+        auto engine = std::mt19937_64(7);
+        auto distribution = std::uniform_int_distribution<std::int64_t>(-(std::int64_t(1) << 50), std::int64_t(1) << 50);
+        for(int i = 0; i < 1000; ++i) {
+            auto const a = fixed::from_raw(distribution(engine));
+            auto const b = fixed::from_raw(distribution(engine) | 1);
+            REQUIRE(hz::math::detail::multiply_shift_portable(a.get_raw(), b.get_raw(), fixed::fraction_bits) == (a * b).get_raw());
+            REQUIRE(hz::math::detail::shift_divide_portable(a.get_raw() >> 20, b.get_raw(), fixed::fraction_bits) == (fixed::from_raw(a.get_raw() >> 20) / b).get_raw());
+        }
+    }
+}
@@ -0,0 +1,124 @@
+#if _MSC_VER
+#define _SILENCE_CXX17_UNCAUGHT_EXCEPTION_DEPRECATION_WARNING
+#endif 
+
+#include <catch.hpp>
+
+#include <cmath>
+
+#include <math/integration.h>
+
+namespace {
+    auto constexpr pi = 3.14159265358979323846;
+
+    // Unit harmonic oscillator x'' = -x from x = 1, v = 0. Returns the position error after one period of n steps
+    template<typename Integrator>
+    auto oscillator_error(int n) -> double {
+        auto const h = 2.0 * pi / n;
+        auto const spring = [] (double, double x, double) { return -x; };
+        auto x = 1.0;
+        auto v = 0.0;
+        for(int i = 0; i < n; ++i) {
+            std::tie(x, v) = Integrator::step(x, v, spring, i * h, h);
+        }
+        return std::abs(x - 1.0) + std::abs(v);
+    }
+
+    // Error ratio when halving the step, close to 2^order
+    template<typename Integrator>
+    auto convergence_order(int n) -> double {
+        return std::log2(oscillator_error<Integrator>(n) / oscillator_error<Integrator>(2 * n));
+    }
+
+    template<typename Integrator>
+    auto energy_drift(int periods, int steps_per_period) -> double {
+        auto const h = 2.0 * pi / steps_per_period;
+        auto const spring = [] (double, double x, double) { return -x; };
+        auto x = 1.0;
+        auto v = 0.0;
+        for(int i = 0; i < periods * steps_per_period; ++i) {
+            std::tie(x, v) = Integrator::step(x, v, spring, i * h, h);
+        }
+        return std::abs((x * x + v * v) / 2.0 - 0.5);
+    }
+}
+
+TEST_CASE("Integrator order", "[math]") {
+    using namespace hz::math;
+
+    REQUIRE(convergence_order<euler>(1000) == Approx(1.0).margin(0.1));
+    REQUIRE(convergence_order<velocity_verlet>(100) == Approx(2.0).margin(0.1));
+    REQUIRE(convergence_order<rk2>(100) == Approx(2.0).margin(0.1));
+    REQUIRE(convergence_order<rk4>(50) == Approx(4.0).margin(0.1));
+    REQUIRE(convergence_order<yoshida4>(50) == Approx(4.0).margin(0.1));
+
+    REQUIRE(oscillator_error<rk4>(50) < oscillator_error<rk2>(50));
+    REQUIRE(oscillator_error<yoshida4>(50) < oscillator_error<velocity_verlet>(50));
+}
+
+TEST_CASE("Symplectic integrators keep energy bounded", "[math]") {
+    using namespace hz::math;
+
+    // A thousand periods at 20 steps each: midpoint RK2 keeps gaining energy, the symplectic schemes do not
+    REQUIRE(energy_drift<rk2>(1000, 20) > 1.0);
+    REQUIRE(energy_drift<velocity_verlet>(1000, 20) < 0.05);
+    REQUIRE(energy_drift<yoshida4>(1000, 20) < 0.001);
+}
+
+TEST_CASE("Dormand-Prince error estimate", "[math]") {
+    using namespace hz::math;
+
+    auto const spring = [] (double, double x, double) { return -x; };
+    auto const run = [spring] (int n) {
+        auto const h = 2.0 * pi / n;
+        auto x = 1.0;
+        auto v = 0.0;
+        auto estimated = 0.0;
+        for(int i = 0; i < n; ++i) {
+            auto const result = dormand_prince::step(x, v, spring, i * h, h);
+            x = result.x;
+            v = result.v;
+            estimated += std::abs(result.x_error) + std::abs(result.v_error);
+        }
+        return std::make_pair(std::abs(x - 1.0) + std::abs(v), estimated);
+    };
+
+    auto const [coarse_error, coarse_estimate] = run(20);
+    auto const [fine_error, fine_estimate] = run(40);
+    REQUIRE(std::log2(coarse_error / fine_error) == Approx(5.0).margin(0.3));
+    // The estimate is that of the fourth order solution, so it bounds the error of the fifth order one.
+    // Summed over the steps of a period, local estimates of order h^5 shrink as h^4
+    REQUIRE(coarse_estimate > coarse_error);
+    REQUIRE(std::log2(coarse_estimate / fine_estimate) == Approx(4.0).margin(0.3));
+}
+
+TEST_CASE("Adaptive integration", "[math]") {
+    using namespace hz::math;
+
+    auto const spring = [] (double, double x, double) { return -x; };
+    auto const integrate_period = [spring] (double tolerance) {
+        auto const norm = [tolerance] (double x_error, double v_error, double, double) {
+            return std::max(std::abs(x_error), std::abs(v_error)) / tolerance;
+        };
+        return integrate_adaptive(1.0, 0.0, spring, 0.0, 2.0 * pi, 2.0 * pi, norm);
+    };
+
+    auto const loose = integrate_period(1e-4);
+    auto const tight = integrate_period(1e-10);
+    REQUIRE(std::abs(loose.x - 1.0) < 1e-2);
+    REQUIRE(std::abs(tight.x - 1.0) < 1e-8);
+    REQUIRE(std::abs(tight.v) < 1e-8);
+    REQUIRE(tight.accepted > loose.accepted);
+    // The first step covers the whole period and has to be rejected
+    REQUIRE(loose.rejected > 0);
+
+    SECTION("Ends exactly on the interval") {
+        auto const norm = [] (double, double, double, double) { return 0.0; };
+        auto const constant = [] (double, double, double) { return 2.0; };
+        auto const result = integrate_adaptive(0.0, 0.0, constant, 0.0, 1.0, 0.3, norm);
+        REQUIRE(result.x == Approx(1.0));
+        REQUIRE(result.v == Approx(2.0));
+        REQUIRE(result.accepted == 2);
+    }
+}
+
@@ -59,4 +59,34 @@ TEST_CASE("Math vector value", "[math]") {
     REQUIRE(value_vector / -100.0 == vector2d{value_vector.x / -100.0, value_vector.y / -100.0});
     REQUIRE(vector2d{value_vector} == value_vector);
 
-}
\ No newline at end of file
+}
+
+TEST_CASE("Math vector interpolation", "[math]") {
+    using hz::math::vector2d;
+    using hz::math::lerp;
+
+    auto const from = vector2d{1.0, -2.0};
+    auto const to = vector2d{3.0, 2.0};
+
+    REQUIRE(lerp(from, to, 0.0) == from);
+    REQUIRE(lerp(from, to, 1.0) == to);
+    REQUIRE(lerp(from, to, 0.5) == vector2d{2.0, 0.0});
+    REQUIRE(lerp(from, from, 0.25) == from);
+}
+
+TEST_CASE("Math vector single precision", "[math]") {
+    using hz::math::vector2d;
+    using hz::math::vector2f;
+    using hz::math::vector_cast;
+
+    static_assert(sizeof(vector2f) == 2 * sizeof(float));
+
+    auto const value_vector = vector2f{1.5f, -2.0f};
+    REQUIRE(value_vector * 2.0 == vector2f{3.0f, -4.0f});
+    REQUIRE(2 * value_vector == vector2f{3.0f, -4.0f});
+    REQUIRE(value_vector / 2.0f == vector2f{0.75f, -1.0f});
+    REQUIRE(hz::math::scalar_product(value_vector, value_vector) == 6.25f);
+    REQUIRE(hz::math::lerp(value_vector, vector2f{}, 0.5) == vector2f{0.75f, -1.0f});
+    REQUIRE(vector_cast<double>(value_vector) == vector2d{1.5, -2.0});
+    REQUIRE(vector_cast<float>(vector2d{1.5, -2.0}) == value_vector);
+}
@@ -0,0 +1,82 @@
+#if _MSC_VER
+#define _SILENCE_CXX17_UNCAUGHT_EXCEPTION_DEPRECATION_WARNING
+#endif 
+
+#include <catch.hpp>
+
+#include <array>
+#include <stdexcept>
+#include <vector>
+
+#include <model/world.h>
+
+using namespace std::chrono_literals;
+
+namespace {
+    template<std::size_t N>
+    struct payload_component {
+        void on_update(hz::model::entity & entity) {
+            entity.body.add_force({payload[0], payload[N - 1]});
+        }
+
+        std::array<double, N> payload = {};
+    };
+
+    struct throwing_copy_component {
+        throwing_copy_component() = default;
+        throwing_copy_component(throwing_copy_component const&) {
+            throw std::runtime_error("copy");
+        }
+        throwing_copy_component(throwing_copy_component &&) noexcept = default;
+
+        void on_update(hz::model::entity &) {
+
+        }
+    };
+}
+
+TEST_CASE("Entity component storage", "[model]") {
+    using hz::model::entity_component;
+
+    auto body_storage = hz::physics::body_storage2d();
+    body_storage.push_back(hz::physics::body2d());
+    auto e = hz::model::entity();
+    e.body = body_storage[0];
+
+    auto const check = [&] (auto component) {
+        component.payload.front() = 1.0;
+        component.payload.back() = 2.0;
+
+        auto components = std::vector<entity_component>();
+        components.push_back(component);
+        auto const copy = components;
+        components.push_back(std::move(components.front()));
+        components.erase(components.begin());
+        auto moved = std::move(components);
+
+        body_storage.get_accelerations()[0] = hz::physics::acceleration2d();
+        for(auto c : copy) {
+            c.on_update(e, hz::input::event_state_t(), 1s);
+        }
+        for(auto & c : moved) {
+            c.on_update(e, hz::input::event_state_t(), 1s);
+        }
+        REQUIRE(body_storage.get_accelerations()[0].value == hz::math::vector2d{2.0, 4.0});
+        REQUIRE(moved.front().get_type() == copy.front().get_type());
+    };
+
+    SECTION("Inline") {
+        check(payload_component<2>());
+    }
+
+    SECTION("Heap") {
+        check(payload_component<32>());
+    }
+
+    SECTION("Throwing copy assignment") {
+        auto component = entity_component(payload_component<2>());
+        auto const throwing = entity_component(throwing_copy_component());
+        REQUIRE_THROWS_AS(component = throwing, std::runtime_error);
+        REQUIRE(component.get_type() == typeid(payload_component<2>));
+    }
+}
@@ -0,0 +1,202 @@
+#if _MSC_VER
+#define _SILENCE_CXX17_UNCAUGHT_EXCEPTION_DEPRECATION_WARNING
+#endif 
+
+#include <catch.hpp>
+
+#include <cstdint>
+
+#include <model/static_world.h>
+#include <model/world.h>
+
+using namespace std::chrono_literals;
+
+namespace {
+    struct push_component {
+        void on_update(hz::model::entity & entity) {
+            entity.body.add_force({force, 0.0});
+        }
+
+        void hash_state(hz::hash::state_hasher & hasher) const {
+            hasher.update_value(force);
+        }
+
+        double force = 1.0;
+    };
+
+    struct tick_component {
+        void on_update(hz::model::entity &, hz::physics::seconds dt) {
+            elapsed += dt;
+        }
+
+        hz::physics::seconds elapsed = {};
+    };
+
+    struct tick_index_component {
+        void on_update(hz::model::entity &, hz::physics::tick_time time) {
+            last_tick = time.index;
+            elapsed += time.dt;
+        }
+
+        std::uint64_t last_tick = 0;
+        hz::physics::seconds elapsed = {};
+    };
+}
+
+TEST_CASE("World archetypes", "[model]") {
+    using hz::model::entity;
+    using hz::model::world;
+
+    auto make_entity = [] (auto... components) {
+        auto e = entity();
+        (e.components.push_back(components), ...);
+        return e;
+    };
+
+    auto w = world();
+    w.add_entity(make_entity(push_component{1.0}, tick_component()));
+    w.add_entity(make_entity(push_component{2.0}));
+    w.add_entity(make_entity(tick_component(), push_component{3.0}));
+    w.add_entity(make_entity());
+
+    REQUIRE(w.get_entities().size() == 4);
+    REQUIRE(w.get_archetypes().size() == 3);
+    for(auto const& e : w.get_entities()) {
+        REQUIRE(e.components.empty());
+    }
+
+    auto push_count = 0;
+    w.for_each_column<push_component>([&push_count] (auto data, auto owners) {
+        REQUIRE(data.size() == owners.size());
+        push_count += static_cast<int>(data.size());
+    });
+    REQUIRE(push_count == 3);
+
+    SECTION("Update") {
+        w.update_components(hz::input::event_state_t(), 1s);
+        auto const accelerations = w.get_bodies().get_accelerations();
+        REQUIRE(accelerations[0].value.x == 1.0);
+        REQUIRE(accelerations[1].value.x == 2.0);
+        REQUIRE(accelerations[2].value.x == 3.0);
+        REQUIRE(accelerations[3].value.x == 0.0);
+
+        w.for_each_column<tick_component>([] (auto data, auto) {
+            for(auto const& tick : data) {
+                REQUIRE(tick.elapsed == 1s);
+            }
+        });
+    }
+
+    SECTION("Tick index") {
+        w.add_entity(make_entity(tick_index_component()));
+        w.update_components(hz::input::event_state_t(), {1s, 41});
+        w.update_components(hz::input::event_state_t(), {1s, 42});
+        w.for_each_column<tick_index_component>([] (auto data, auto) {
+            REQUIRE(data.size() == 1);
+            REQUIRE(data[0].last_tick == 42);
+            REQUIRE(data[0].elapsed == 2s);
+        });
+    }
+
+    SECTION("Parallel update") {
+        auto pool = hz::thread::job_pool(2);
+        w.update_components(hz::input::event_state_t(), 1s, pool, 1);
+        auto const accelerations = w.get_bodies().get_accelerations();
+        REQUIRE(accelerations[0].value.x == 1.0);
+        REQUIRE(accelerations[1].value.x == 2.0);
+        REQUIRE(accelerations[2].value.x == 3.0);
+        REQUIRE(accelerations[3].value.x == 0.0);
+    }
+
+    SECTION("Copy") {
+        auto copy = w;
+        copy.update_components(hz::input::event_state_t(), 1s);
+        REQUIRE(copy.get_bodies().get_accelerations()[2].value.x == 3.0);
+        REQUIRE(w.get_bodies().get_accelerations()[2].value.x == 0.0);
+    }
+
+    SECTION("State hash") {
+        auto const digest = [] (world const& w) {
+            auto hasher = hz::hash::state_hasher();
+            w.hash_state(hasher);
+            return hasher.digest();
+        };
+        auto const initial = digest(w);
+        REQUIRE(digest(w) == initial);
+        REQUIRE(digest(world(w)) == initial);
+
+        auto pool = hz::thread::job_pool(2);
+        auto parallel = hz::hash::state_hasher();
+        w.hash_state(parallel, pool);
+        REQUIRE(parallel.digest() == initial);
+
+        // Several body chunks
+        auto large = world();
+        for(auto i = 0; i < 10000; ++i) {
+            auto body = hz::physics::body2d();
+            body.position = hz::physics::position2d(i, -i);
+            large.add_entity(entity(), body);
+        }
+        auto large_parallel = hz::hash::state_hasher();
+        large.hash_state(large_parallel, pool);
+        REQUIRE(large_parallel.digest() == digest(large));
+
+        // Only the chunks flagged as changed are rehashed
+        auto const incremental = [&pool] (world & w) {
+            auto hasher = hz::hash::state_hasher();
+            w.hash_changed_state(hasher, pool);
+            return hasher.digest();
+        };
+        REQUIRE(incremental(large) == digest(large));
+        large.get_bodies().get_positions()[5000].value.x += 1.0;
+        auto const stale = incremental(large);
+        REQUIRE(stale != digest(large));
+        large.mark_bodies_changed(5000, 5001);
+        REQUIRE(incremental(large) == digest(large));
+        large.add_entity(entity());
+        REQUIRE(incremental(large) == digest(large));
+
+        // Only push_component opts in
+        w.for_each_column<tick_component>([] (auto data, auto) {
+            for(auto & tick : data) {
+                tick.elapsed = 1s;
+            }
+        });
+        REQUIRE(digest(w) == initial);
+
+        w.for_each_column<push_component>([] (auto data, auto) {
+            data[0].force = 4.0;
+        });
+        auto const changed_component = digest(w);
+        REQUIRE(changed_component != initial);
+
+        w.get_bodies().get_velocities()[3].value.y = 1.0;
+        REQUIRE(digest(w) != changed_component);
+    }
+}
+
+TEST_CASE("Static world", "[model]") {
+    using static_world = hz::model::static_world<push_component, tick_component>;
+    static_assert(static_world::has_component<push_component>);
+    static_assert(!static_world::has_component<int>);
+
+    auto w = static_world();
+    w.add_entity(hz::physics::body2d(), push_component{1.0}, tick_component());
+    w.add_entity(hz::physics::body2d(), push_component{2.0});
+    w.add_entity(hz::physics::body2d(), tick_component());
+
+    REQUIRE(w.get_entities().size() == 3);
+    REQUIRE(w.get_components<push_component>().get_data().size() == 2);
+    REQUIRE(w.get_components<tick_component>().get_data().size() == 2);
+
+    auto copy = w;
+    copy.update_components(hz::input::event_state_t(), 1s);
+    auto const accelerations = copy.get_bodies().get_accelerations();
+    REQUIRE(accelerations[0].value.x == 1.0);
+    REQUIRE(accelerations[1].value.x == 2.0);
+    REQUIRE(accelerations[2].value.x == 0.0);
+    REQUIRE(w.get_bodies().get_accelerations()[0].value.x == 0.0);
+    for(auto const& tick : copy.get_components<tick_component>().get_data()) {
+        REQUIRE(tick.elapsed == 1s);
+    }
+}
@@ -0,0 +1,116 @@
+#if _MSC_VER
+#define _SILENCE_CXX17_UNCAUGHT_EXCEPTION_DEPRECATION_WARNING
+#endif 
+
+#include <catch.hpp>
+
+#include <algorithm>
+#include <random>
+#include <vector>
+
+#include <physics/aabb_tree.h>
+
+TEST_CASE("AABB tree", "[physics]") {
+    using hz::physics::aabb2d;
+    using hz::physics::aabb_tree;
+    using hz::math::vector2d;
+
+    auto engine = std::mt19937(11);
+    auto coordinate = std::uniform_real_distribution<double>(-100.0, 100.0);
+    auto size = std::uniform_real_distribution<double>(0.5, 5.0);
+    auto const random_box = [&] {
+        auto const min = vector2d{coordinate(engine), coordinate(engine)};
+        return aabb2d{min, min + vector2d{size(engine), size(engine)}};
+    };
+
+    auto tree = aabb_tree(0.5);
+    auto boxes = std::vector<aabb2d>();
+    auto proxies = std::vector<aabb_tree::proxy_id>();
+    auto alive = std::vector<bool>();
+    for(std::uint32_t i = 0; i < 1000; ++i) {
+        boxes.push_back(random_box());
+        proxies.push_back(tree.insert(boxes.back(), i));
+        alive.push_back(true);
+    }
+
+    auto const check = [&] {
+        auto results = std::vector<std::uint32_t>(2048);
+        for(int q = 0; q < 50; ++q) {
+            auto const query_box = aabb2d{vector2d{coordinate(engine), coordinate(engine)}, vector2d{}};
+            auto const region = aabb2d{query_box.min, query_box.min + vector2d{20.0, 20.0}};
+            auto const count = tree.query(region, results);
+            auto found = std::vector<std::uint32_t>(results.begin(), results.begin() + count);
+            std::sort(found.begin(), found.end());
+
+            auto expected = std::vector<std::uint32_t>();
+            for(std::uint32_t i = 0; i < boxes.size(); ++i) {
+                if(alive[i] && boxes[i].overlaps(region)) {
+                    expected.push_back(i);
+                }
+            }
+            REQUIRE(found == expected);
+
+            auto const point = region.min;
+            auto const point_count = tree.query(point, results);
+            found.assign(results.begin(), results.begin() + point_count);
+            std::sort(found.begin(), found.end());
+            expected.clear();
+            for(std::uint32_t i = 0; i < boxes.size(); ++i) {
+                if(alive[i] && boxes[i].contains(point)) {
+                    expected.push_back(i);
+                }
+            }
+            REQUIRE(found == expected);
+        }
+    };
+
+    check();
+    REQUIRE(tree.get_height() <= 24);
+
+    SECTION("Move and remove") {
+        auto step = std::uniform_real_distribution<double>(-1.0, 1.0);
+        for(int frame = 0; frame < 10; ++frame) {
+            for(std::size_t i = 0; i < boxes.size(); ++i) {
+                if(!alive[i]) {
+                    continue;
+                }
+                auto const offset = vector2d{step(engine), step(engine)};
+                boxes[i] = aabb2d{boxes[i].min + offset, boxes[i].max + offset};
+                tree.move(proxies[i], boxes[i]);
+            }
+            for(std::size_t i = frame; i < boxes.size(); i += 37) {
+                if(alive[i]) {
+                    tree.remove(proxies[i]);
+                    alive[i] = false;
+                }
+            }
+        }
+        check();
+        REQUIRE(tree.get_height() <= 24);
+    }
+
+    SECTION("Raycast") {
+        auto hits = std::vector<hz::physics::ray_hit>(1024);
+        auto const from = vector2d{-120.0, -3.0};
+        auto const to = vector2d{120.0, 4.0};
+        auto const count = tree.raycast(from, to, hits);
+        REQUIRE(count <= hits.size());
+
+        auto found = std::vector<std::uint32_t>();
+        for(std::size_t i = 0; i < count; ++i) {
+            found.push_back(hits[i].user);
+            REQUIRE(hits[i].fraction >= 0.0);
+            REQUIRE(hits[i].fraction <= 1.0);
+        }
+        std::sort(found.begin(), found.end());
+
+        auto expected = std::vector<std::uint32_t>();
+        for(std::uint32_t i = 0; i < boxes.size(); ++i) {
+            if(hz::physics::intersect_segment(boxes[i], from, to - from)) {
+                expected.push_back(i);
+            }
+        }
+        REQUIRE(found == expected);
+        REQUIRE(!expected.empty());
+    }
+}
@@ -0,0 +1,58 @@
+#if _MSC_VER
+#define _SILENCE_CXX17_UNCAUGHT_EXCEPTION_DEPRECATION_WARNING
+#endif 
+
+#include <catch.hpp>
+
+#include <cmath>
+
+#include <physics/adaptive_integrator.h>
+
+using namespace std::chrono_literals;
+
+TEST_CASE("Adaptive integrator", "[physics]") {
+    using hz::physics::acceleration2d;
+    using hz::physics::body2d;
+    using hz::physics::body_storage2d;
+    using hz::physics::position2d;
+    using hz::physics::velocity2d;
+
+    // Point mass at the origin with GM = 1: a circular orbit of radius r has speed 1 / sqrt(r)
+    auto const gravity_well = [] (position2d p, velocity2d) {
+        auto const r = std::sqrt(hz::math::scalar_product(p.value, p.value));
+        return acceleration2d(p.value * (-1.0 / (r * r * r)));
+    };
+    auto const orbiting = [] (double radius) {
+        auto b = body2d();
+        b.position = position2d(radius, 0.0);
+        b.velocity = velocity2d(0.0, 1.0 / std::sqrt(radius));
+        return b;
+    };
+    auto const radius_of = [] (body_storage2d const& bodies, std::size_t i) {
+        auto const p = bodies.get_positions()[i].value;
+        return std::sqrt(hz::math::scalar_product(p, p));
+    };
+
+    auto bodies = body_storage2d();
+    bodies.push_back(orbiting(100.0));
+    bodies.push_back(orbiting(0.05));
+
+    auto const dt = 1s / 60.0;
+    auto integrator = hz::physics::adaptive_integrator();
+    for(int tick = 0; tick < 60; ++tick) {
+        integrator.integrate(bodies, gravity_well, dt);
+    }
+
+    REQUIRE(radius_of(bodies, 0) == Approx(100.0).epsilon(1e-6));
+    REQUIRE(radius_of(bodies, 1) == Approx(0.05).epsilon(1e-3));
+    // The wide orbit barely curves within a tick, the tight one needs sub-steps
+    REQUIRE(integrator.get_step(0) >= dt);
+    REQUIRE(integrator.get_step(1) < dt / 2.0);
+
+    SECTION("Ranges only touch their bodies") {
+        auto const before = bodies.load(1);
+        integrator.integrate(bodies, gravity_well, dt, 0, 1);
+        REQUIRE(bodies.load(1).position.value == before.position.value);
+        REQUIRE(bodies.load(1).velocity.value == before.velocity.value);
+    }
+}
@@ -51,4 +51,18 @@ TEST_CASE("Body integration", "[physics]") {
             REQUIRE(test_body2.position.value.x == Approx(body_origin.position.value.x + body_origin.velocity.value.x));
         }
     }
-}
\ No newline at end of file
+
+    SECTION("Spring field") {
+        // Unit mass on a unit spring, with a quarter period of steps: the body should end at the origin at full speed
+        auto const spring = [] (position2d p, velocity2d) { return acceleration2d(-p.value); };
+        auto body = body2d();
+        body.position = position2d(1.0, 0.0);
+        auto constexpr steps = 100;
+        auto const dt = hz::physics::seconds(3.14159265358979323846 / 2.0 / steps);
+        for(int i = 0; i < steps; ++i) {
+            body = hz::physics::integrate<hz::math::rk4>(body, spring, dt);
+        }
+        REQUIRE(body.position.value.x == Approx(0.0).margin(1e-9));
+        REQUIRE(body.velocity.value.x == Approx(-1.0).epsilon(1e-9));
+    }
+}
@@ -0,0 +1,68 @@
+#if _MSC_VER
+#define _SILENCE_CXX17_UNCAUGHT_EXCEPTION_DEPRECATION_WARNING
+#endif 
+
+#include <catch.hpp>
+
+#include <limits>
+
+#include <physics/body_storage.h>
+
+using namespace std::chrono_literals;
+
+TEST_CASE("Body storage", "[physics]") {
+    using hz::physics::body2d;
+    using hz::physics::body_storage2d;
+    using hz::physics::position2d;
+    using hz::physics::velocity2d;
+    using hz::physics::acceleration2d;
+    using hz::physics::force2d;
+
+    auto body = body2d();
+    body.position = position2d(1.0, 2.0);
+    body.velocity = velocity2d(3.0, -4.0);
+    body.acceleration = acceleration2d(0.5, -10.0);
+    body.dimension = {2.0, 3.0};
+    body.weight = {4.0};
+
+    auto storage = body_storage2d();
+    storage.push_back(body2d());
+    auto const index = storage.push_back(body);
+    REQUIRE(storage.size() == 2);
+    REQUIRE(index == 1);
+
+    SECTION("Columns") {
+        REQUIRE(storage.get_positions()[1].value == body.position.value);
+        REQUIRE(storage.get_velocities()[1].value == body.velocity.value);
+        REQUIRE(storage.get_accelerations()[1].value == body.acceleration.value);
+        REQUIRE(storage.get_dimensions()[1] == body.dimension);
+        REQUIRE(storage.get_weights()[1].value == body.weight.value);
+        REQUIRE(storage.load(1).position.value == body.position.value);
+    }
+
+    SECTION("Reference") {
+        auto const ref = storage[1];
+        ref.add_force(force2d(4.0, 4.0));
+        REQUIRE(storage.get_accelerations()[1].value == body.acceleration.value + hz::math::vector2d{1.0, 1.0});
+        REQUIRE(storage.get_accelerations()[0].value == hz::math::vector2d{});
+
+        ref.add_acceleration(acceleration2d(0.0, -10.0));
+        REQUIRE(storage.get_accelerations()[1].value == body.acceleration.value + hz::math::vector2d{1.0, -9.0});
+    }
+
+    SECTION("Static bodies take no acceleration") {
+        auto wall = body2d();
+        wall.weight = {std::numeric_limits<double>::infinity()};
+        auto const ref = storage[storage.push_back(wall)];
+        ref.wake();
+        ref.add_acceleration(acceleration2d(0.0, -10.0));
+        REQUIRE(storage.get_accelerations()[2].value == hz::math::vector2d{});
+    }
+
+    SECTION("Integration") {
+        hz::physics::integrate(storage, 1s / 60.0);
+        auto const expected = hz::physics::integrate(body, 1s / 60.0);
+        REQUIRE(storage.get_positions()[1].value == expected.position.value);
+        REQUIRE(storage.get_velocities()[1].value == expected.velocity.value);
+    }
+}
@@ -0,0 +1,115 @@
+#if _MSC_VER
+#define _SILENCE_CXX17_UNCAUGHT_EXCEPTION_DEPRECATION_WARNING
+#endif 
+
+#include <catch.hpp>
+
+#include <algorithm>
+#include <cstdint>
+#include <random>
+#include <vector>
+
+#include <physics/broad_phase.h>
+
+TEST_CASE("Spatial hash broad phase", "[physics]") {
+    using hz::physics::aabb2d;
+    using hz::physics::collision_filter;
+    using hz::physics::position2d;
+    using hz::physics::proxy_pair;
+    using hz::math::vector2d;
+
+    auto engine = std::mt19937(7);
+    auto coordinate = std::uniform_real_distribution<double>(-50.0, 50.0);
+    auto size = std::uniform_real_distribution<double>(0.1, 6.0);
+
+    auto positions = std::vector<position2d>();
+    auto dimensions = std::vector<vector2d>();
+    for(int i = 0; i < 300; ++i) {
+        positions.push_back(position2d(coordinate(engine), coordinate(engine)));
+        dimensions.push_back(vector2d{size(engine), size(engine)});
+    }
+    auto filters = std::vector<collision_filter>(positions.size());
+    for(std::size_t i = 0; i < filters.size(); i += 3) {
+        filters[i] = collision_filter{0x2, 0x2};
+    }
+
+    auto const brute_force = [&] {
+        auto pairs = std::vector<proxy_pair>();
+        for(std::uint32_t i = 0; i < positions.size(); ++i) {
+            for(auto j = i + 1; j < positions.size(); ++j) {
+                if(hz::physics::can_collide(filters[i], filters[j])
+                   && hz::physics::make_aabb(positions[i], dimensions[i]).overlaps(hz::physics::make_aabb(positions[j], dimensions[j]))) {
+                    pairs.push_back(proxy_pair{i, j});
+                }
+            }
+        }
+        return pairs;
+    };
+
+    auto broad_phase = hz::physics::spatial_hash(4.0);
+    auto const find_pairs = [&broad_phase] {
+        auto pairs = std::vector<proxy_pair>(16);
+        auto count = broad_phase.find_pairs(pairs);
+        if(count > pairs.size()) {
+            pairs.resize(count);
+            count = broad_phase.find_pairs(pairs);
+        }
+        pairs.resize(count);
+        std::sort(pairs.begin(), pairs.end());
+        return pairs;
+    };
+
+    broad_phase.update(positions, dimensions);
+    for(std::uint32_t i = 0; i < filters.size(); ++i) {
+        broad_phase.set_filter(i, filters[i]);
+    }
+    REQUIRE(broad_phase.size() == positions.size());
+    REQUIRE(find_pairs() == brute_force());
+
+    auto step = std::uniform_real_distribution<double>(-3.0, 3.0);
+    for(int frame = 0; frame < 5; ++frame) {
+        for(auto & position : positions) {
+            position.value += vector2d{step(engine), step(engine)};
+        }
+        broad_phase.update(positions, dimensions);
+        REQUIRE(find_pairs() == brute_force());
+    }
+
+    SECTION("Large and far boxes") {
+        // Covers far more than max_cells_per_proxy cells, and so is tested against every proxy
+        positions.push_back(position2d(0.0, 0.0));
+        dimensions.push_back(vector2d{1e4, 30.0});
+        positions.push_back(position2d(10.0, 10.0));
+        dimensions.push_back(vector2d{500.0, 500.0});
+        // Cell coordinates beyond the int32 range saturate
+        positions.push_back(position2d(1e10, -1e12));
+        dimensions.push_back(vector2d{1.0, 1.0});
+        positions.push_back(position2d(1e10 + 0.5, -1e12));
+        dimensions.push_back(vector2d{1.0, 1.0});
+        positions.push_back(position2d(1e10, 5.0));
+        dimensions.push_back(vector2d{1.0, 1.0});
+        filters.resize(positions.size());
+        broad_phase.update(positions, dimensions);
+        REQUIRE(find_pairs() == brute_force());
+
+        // A large box shrinking back into the grid, and a small one growing out of it
+        dimensions[dimensions.size() - 4] = vector2d{2.0, 2.0};
+        dimensions[0] = vector2d{400.0, 400.0};
+        broad_phase.update(positions, dimensions);
+        REQUIRE(find_pairs() == brute_force());
+
+        // Only pairs with an awake proxy, whether or not it is large
+        auto awake = std::vector<std::uint8_t>(positions.size(), 0);
+        auto active = std::vector<std::uint32_t>();
+        for(std::uint32_t i = 0; i < awake.size(); i += 7) {
+            awake[i] = 1;
+            active.push_back(i);
+        }
+        auto expected = brute_force();
+        expected.erase(std::remove_if(expected.begin(), expected.end(), [&awake] (proxy_pair p) { return !awake[p.first] && !awake[p.second]; }), expected.end());
+        auto pairs = std::vector<proxy_pair>(positions.size() * positions.size());
+        pairs.resize(broad_phase.find_pairs(pairs, awake, active));
+        std::sort(pairs.begin(), pairs.end());
+        REQUIRE(pairs == expected);
+    }
+}
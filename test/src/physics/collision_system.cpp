@@ -0,0 +1,119 @@
+#if _MSC_VER
+#define _SILENCE_CXX17_UNCAUGHT_EXCEPTION_DEPRECATION_WARNING
+#endif 
+
+#include <catch.hpp>
+
+#include <cstdint>
+#include <limits>
+#include <vector>
+
+#include <physics/collision_system.h>
+
+using namespace std::chrono_literals;
+
+TEST_CASE("Collision system", "[physics]") {
+    using hz::physics::body2d;
+    using hz::physics::body_storage2d;
+    using hz::physics::collision_system;
+    using hz::physics::force2d;
+    using hz::physics::position2d;
+    using hz::physics::velocity2d;
+
+    auto const dt = 1s / 60.0;
+    auto const infinity = std::numeric_limits<double>::infinity();
+
+    auto floor = body2d();
+    floor.position = position2d(0.0, -1.0);
+    floor.dimension = {20.0, 2.0};
+    floor.weight = {infinity};
+
+    auto const simulate = [dt] (body_storage2d & bodies, collision_system & collisions, int ticks) {
+        for(int tick = 0; tick < ticks; ++tick) {
+            for(std::size_t i = 0; i < bodies.size(); ++i) {
+                if(hz::physics::get_inverse_mass(bodies.get_weights()[i]) > 0.0) {
+                    bodies[i].add_force(force2d(0.0, -10.0 * bodies.get_weights()[i].value));
+                }
+            }
+            hz::physics::integrate(bodies, dt);
+            auto const accelerations = bodies.get_accelerations();
+            std::fill(accelerations.begin(), accelerations.end(), hz::physics::acceleration2d());
+            collisions.step(bodies);
+        }
+    };
+
+    SECTION("Stack rests on the floor") {
+        auto bodies = body_storage2d();
+        bodies.push_back(floor);
+        for(int i = 0; i < 5; ++i) {
+            auto box = body2d();
+            box.position = position2d(0.0, 0.5 + i * 1.0);
+            bodies.push_back(box);
+        }
+
+        auto collisions = collision_system(2.0);
+        simulate(bodies, collisions, 300);
+
+        REQUIRE(bodies.get_positions()[0].value == floor.position.value);
+        for(int i = 1; i <= 5; ++i) {
+            REQUIRE(bodies.get_positions()[i].value.y == Approx(0.5 + (i - 1) * 1.0).margin(0.1));
+            REQUIRE(bodies.get_velocities()[i].value.y == Approx(0.0).margin(0.05));
+        }
+        REQUIRE(!collisions.get_contacts().empty());
+    }
+
+    SECTION("Filtered bodies pass through") {
+        auto bodies = body_storage2d();
+        bodies.push_back(floor);
+        auto box = body2d();
+        box.position = position2d(0.0, 2.0);
+        bodies.push_back(box);
+
+        auto collisions = collision_system(2.0);
+        collisions.set_filter(1, hz::physics::collision_filter{0x2, 0x2});
+        simulate(bodies, collisions, 120);
+
+        REQUIRE(bodies.get_positions()[1].value.y < -2.0);
+        REQUIRE(collisions.get_contacts().empty());
+    }
+
+    SECTION("Queries follow the bodies") {
+        auto bodies = body_storage2d();
+        bodies.push_back(floor);
+        auto box = body2d();
+        box.position = position2d(5.0, 3.0);
+        bodies.push_back(box);
+
+        auto collisions = collision_system(2.0);
+        auto found = std::vector<std::uint32_t>(4);
+        simulate(bodies, collisions, 1);
+        REQUIRE(collisions.query(bodies, bodies.get_positions()[1].value, found) == 1);
+        REQUIRE(found[0] == 1);
+
+        // Once the box has landed, it is no longer where it started
+        simulate(bodies, collisions, 120);
+        REQUIRE(collisions.query(bodies, hz::physics::vector2d{5.0, 3.0}, found) == 0);
+        REQUIRE(collisions.query(bodies, hz::physics::vector2d{5.0, 0.5}, found) == 1);
+        REQUIRE(found[0] == 1);
+        REQUIRE(collisions.query(bodies, hz::physics::aabb2d{{-10.0, -2.0}, {10.0, 2.0}}, found) == 2);
+
+        auto hits = std::vector<hz::physics::ray_hit>(4);
+        REQUIRE(collisions.raycast(bodies, {5.0, 10.0}, {5.0, -10.0}, hits) == 2);
+        REQUIRE(collisions.raycast(bodies, {-5.0, 10.0}, {-5.0, -10.0}, hits) == 1);
+        REQUIRE(hits[0].user == 0);
+    }
+
+    SECTION("Restitution") {
+        auto bodies = body_storage2d();
+        bodies.push_back(floor);
+        auto ball = body2d();
+        ball.position = position2d(0.0, 0.55);
+        ball.velocity = velocity2d(0.0, -5.0);
+        ball.material.restitution = 1.0;
+        bodies.push_back(ball);
+
+        auto collisions = collision_system(2.0);
+        simulate(bodies, collisions, 2);
+        REQUIRE(bodies.get_velocities()[1].value.y > 4.0);
+    }
+}
@@ -0,0 +1,145 @@
+#if _MSC_VER
+#define _SILENCE_CXX17_UNCAUGHT_EXCEPTION_DEPRECATION_WARNING
+#endif 
+
+#include <catch.hpp>
+
+#include <random>
+#include <vector>
+
+#include <physics/integrate_batch.h>
+
+// Catches an AVX2 test build whose flags did not reach the compiler, which would test the SSE2 paths twice
+#if defined(AGEA_AVX2) && !defined(__AVX2__)
+#error "AGEA_AVX2 is set but AVX2 code generation is not enabled"
+#endif
+
+using namespace std::chrono_literals;
+
+TEST_CASE("Batch integration", "[physics]") {
+    using hz::physics::body2d;
+    using hz::physics::position2d;
+    using hz::physics::velocity2d;
+    using hz::physics::acceleration2d;
+
+    auto engine = std::mt19937(42);
+    auto distribution = std::uniform_real_distribution<double>(-1000.0, 1000.0);
+    auto const random = [&] { return distribution(engine); };
+
+    // Odd count so that both the vector lanes and the scalar tail are exercised
+    auto constexpr body_count = 37;
+    auto bodies = std::vector<body2d>(body_count);
+    for(auto & body : bodies) {
+        body.position = position2d(random(), random());
+        body.velocity = velocity2d(random(), random());
+        body.acceleration = acceleration2d(random(), random());
+    }
+
+    auto positions = std::vector<position2d>();
+    auto velocities = std::vector<velocity2d>();
+    auto accelerations = std::vector<acceleration2d>();
+    for(auto const& body : bodies) {
+        positions.push_back(body.position);
+        velocities.push_back(body.velocity);
+        accelerations.push_back(body.acceleration);
+    }
+
+    auto const dt = 1s / 60.0;
+
+    SECTION("Constant acceleration") {
+        for(int step = 0; step < 10; ++step) {
+            hz::physics::integrate_batch(positions, velocities, accelerations, dt);
+            for(auto & body : bodies) {
+                body = hz::physics::integrate(body, dt);
+            }
+        }
+
+        for(int i = 0; i < body_count; ++i) {
+            REQUIRE(positions[i].value == bodies[i].position.value);
+            REQUIRE(velocities[i].value == bodies[i].velocity.value);
+        }
+    }
+
+    SECTION("Acceleration field") {
+        auto const spring = [] (position2d p, velocity2d) { return acceleration2d(p.value * -4.0); };
+        for(int step = 0; step < 10; ++step) {
+            hz::physics::integrate_batch<hz::math::rk4>(positions, velocities, accelerations, spring, dt);
+            for(auto & body : bodies) {
+                body = hz::physics::integrate<hz::math::rk4>(body, spring, dt);
+            }
+        }
+
+        for(int i = 0; i < body_count; ++i) {
+            REQUIRE(positions[i].value == bodies[i].position.value);
+            REQUIRE(velocities[i].value == bodies[i].velocity.value);
+        }
+    }
+
+    SECTION("Single precision") {
+        using hz::physics::body2f;
+        using hz::math::vector_cast;
+
+        auto bodies_f = std::vector<body2f>();
+        auto positions_f = std::vector<hz::physics::basic_position2d<float>>();
+        auto velocities_f = std::vector<hz::physics::basic_velocity2d<float>>();
+        auto accelerations_f = std::vector<hz::physics::basic_acceleration2d<float>>();
+        for(auto const& body : bodies) {
+            auto body_f = body2f();
+            body_f.position.value = vector_cast<float>(body.position.value);
+            body_f.velocity.value = vector_cast<float>(body.velocity.value);
+            body_f.acceleration.value = vector_cast<float>(body.acceleration.value);
+            bodies_f.push_back(body_f);
+            positions_f.push_back(body_f.position);
+            velocities_f.push_back(body_f.velocity);
+            accelerations_f.push_back(body_f.acceleration);
+        }
+
+        for(int step = 0; step < 10; ++step) {
+            hz::physics::integrate_batch(positions_f, velocities_f, accelerations_f, dt);
+            for(auto & body : bodies_f) {
+                body = hz::physics::integrate(body, dt);
+            }
+        }
+
+        for(int i = 0; i < body_count; ++i) {
+            REQUIRE(positions_f[i].value == bodies_f[i].position.value);
+            REQUIRE(velocities_f[i].value == bodies_f[i].velocity.value);
+        }
+    }
+
+    SECTION("Fixed point") {
+        using fixed_body = hz::physics::basic_body2d<hz::math::fixed>;
+        using hz::math::fixed;
+
+        auto bodies_x = std::vector<fixed_body>();
+        auto positions_x = std::vector<hz::physics::basic_position2d<fixed>>();
+        auto velocities_x = std::vector<hz::physics::basic_velocity2d<fixed>>();
+        auto accelerations_x = std::vector<hz::physics::basic_acceleration2d<fixed>>();
+        for(auto const& body : bodies) {
+            auto body_x = fixed_body();
+            body_x.position = hz::physics::basic_position2d<fixed>(fixed(body.position.value.x), fixed(body.position.value.y));
+            body_x.velocity = hz::physics::basic_velocity2d<fixed>(fixed(body.velocity.value.x), fixed(body.velocity.value.y));
+            body_x.acceleration = hz::physics::basic_acceleration2d<fixed>(fixed(body.acceleration.value.x), fixed(body.acceleration.value.y));
+            bodies_x.push_back(body_x);
+            positions_x.push_back(body_x.position);
+            velocities_x.push_back(body_x.velocity);
+            accelerations_x.push_back(body_x.acceleration);
+        }
+
+        for(int step = 0; step < 10; ++step) {
+            hz::physics::integrate_batch(positions_x, velocities_x, accelerations_x, dt);
+            for(auto & body : bodies_x) {
+                body = hz::physics::integrate(body, dt);
+            }
+            for(auto & body : bodies) {
+                body = hz::physics::integrate(body, dt);
+            }
+        }
+
+        for(int i = 0; i < body_count; ++i) {
+            REQUIRE(positions_x[i].value == bodies_x[i].position.value);
+            REQUIRE(velocities_x[i].value == bodies_x[i].velocity.value);
+            REQUIRE(positions_x[i].value.x.to_double() == Approx(bodies[i].position.value.x).margin(1e-6));
+        }
+    }
+}
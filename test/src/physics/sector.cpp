@@ -0,0 +1,94 @@
+#if _MSC_VER
+#define _SILENCE_CXX17_UNCAUGHT_EXCEPTION_DEPRECATION_WARNING
+#endif 
+
+#include <catch.hpp>
+
+#include <vector>
+
+#include <physics/sector.h>
+
+using namespace std::chrono_literals;
+
+TEST_CASE("Sector coordinates", "[physics]") {
+    using hz::math::vector2d;
+    using hz::math::vector2f;
+    using hz::physics::sector_position2d;
+
+    SECTION("Round trip") {
+        for(auto const world : {vector2d{0.0, 0.0}, vector2d{-0.5, 1023.75}, vector2d{10000000000.25, -10000000000.5}}) {
+            auto const p = hz::physics::to_sector_position(world);
+            REQUIRE(p.offset.x >= 0.0f);
+            REQUIRE(p.offset.x < hz::physics::sector_size);
+            REQUIRE(p.offset.y >= 0.0f);
+            REQUIRE(p.offset.y < hz::physics::sector_size);
+            REQUIRE(hz::physics::to_world(p) == world);
+        }
+    }
+
+    SECTION("Just below a sector boundary") {
+        for(auto const value : {-1e-9, -1e-12, 1024.0 - 1e-9}) {
+            auto const p = hz::physics::to_sector_position(vector2d{value, value});
+            REQUIRE(p.offset.x >= 0.0f);
+            REQUIRE(p.offset.x < hz::physics::sector_size);
+        }
+        auto const p = hz::physics::to_sector_position(vector2d{-1e-9, 0.0});
+        REQUIRE(p.sector == hz::physics::sector_coordinate{0, 0});
+        REQUIRE(p.offset.x == 0.0f);
+    }
+
+    SECTION("Normalize") {
+        auto const p = hz::physics::normalize(sector_position2d{{3, -2}, vector2f{-1.0f, 2048.5f}});
+        REQUIRE(p.sector == hz::physics::sector_coordinate{2, 0});
+        REQUIRE(p.offset == vector2f{1023.0f, 0.5f});
+    }
+
+    SECTION("Float simulation far from the origin") {
+        // Same motion as the "From far" body test: one unit along x over a second, around 1e10
+        auto const start = hz::physics::to_sector_position(vector2d{10000000000.0, 0.0});
+        auto const origin = start.sector;
+
+        auto body = hz::physics::body2f();
+        body.position.value = hz::physics::to_local(start, origin);
+        body.velocity = hz::physics::basic_velocity2d<float>(1.0f, 0.0f);
+        for(int i = 0; i < 50; ++i) {
+            body = hz::physics::integrate(body, 1s / 50.0);
+        }
+        auto const end = hz::physics::to_world(hz::physics::from_local(body.position.value, origin));
+        REQUIRE(end.x == Approx(10000000001.0).margin(1e-4));
+
+        // Plain float coordinates cannot even represent the move
+        REQUIRE(static_cast<float>(10000000000.0) + 1.0f == static_cast<float>(10000000000.0));
+    }
+
+    SECTION("Floating origin follows the camera") {
+        auto origin = hz::physics::floating_origin();
+        auto positions = std::vector<hz::physics::basic_position2d<float>>{
+            hz::physics::basic_position2d<float>(5000.25f, -3.5f),
+            hz::physics::basic_position2d<float>(-12.0f, 7.0f),
+        };
+        auto const before = std::vector<sector_position2d>{origin.to_sector_position(positions[0].value), origin.to_sector_position(positions[1].value)};
+
+        auto camera = vector2f{100.0f, 0.0f};
+        REQUIRE(!origin.update(camera, positions));
+        REQUIRE(origin.get_origin() == hz::physics::sector_coordinate{0, 0});
+
+        camera = vector2f{5000.0f, -10.0f};
+        REQUIRE(origin.update(camera, positions));
+        REQUIRE(origin.get_origin() == hz::physics::sector_coordinate{4, -1});
+        REQUIRE(camera == vector2f{5000.0f - 4096.0f, -10.0f + 1024.0f});
+        for(std::size_t i = 0; i < positions.size(); ++i) {
+            auto const after = origin.to_sector_position(positions[i].value);
+            REQUIRE(after.sector == before[i].sector);
+            REQUIRE(after.offset == before[i].offset);
+        }
+
+        // Every column is shifted by the same amount
+        auto previous = std::vector<hz::physics::basic_position2d<float>>{hz::physics::basic_position2d<float>(10.0f, 20.0f)};
+        auto current = std::vector<hz::physics::basic_position2d<float>>{hz::physics::basic_position2d<float>(11.0f, 20.0f)};
+        camera = vector2f{-5000.0f, 0.0f};
+        REQUIRE(origin.update(camera, {previous, current}));
+        REQUIRE(current[0].value - previous[0].value == vector2f{1.0f, 0.0f});
+        REQUIRE(previous[0].value == vector2f{10.0f + 5120.0f, 20.0f});
+    }
+}
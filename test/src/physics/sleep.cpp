@@ -0,0 +1,123 @@
+#if _MSC_VER
+#define _SILENCE_CXX17_UNCAUGHT_EXCEPTION_DEPRECATION_WARNING
+#endif 
+
+#include <catch.hpp>
+
+#include <cstdint>
+#include <limits>
+#include <vector>
+
+#include <physics/collision_system.h>
+#include <physics/sleep.h>
+
+using namespace std::chrono_literals;
+
+TEST_CASE("Sleep system", "[physics]") {
+    using hz::physics::body2d;
+    using hz::physics::body_storage2d;
+    using hz::physics::collision_system;
+    using hz::physics::force2d;
+    using hz::physics::position2d;
+    using hz::physics::sleep_system;
+    using hz::physics::velocity2d;
+
+    auto const dt = 1s / 60.0;
+
+    auto floor = body2d();
+    floor.position = position2d(0.0, -1.0);
+    floor.dimension = {40.0, 2.0};
+    floor.weight = {std::numeric_limits<double>::infinity()};
+
+    auto const simulate = [dt] (body_storage2d & bodies, collision_system & collisions, sleep_system & sleeping, int ticks) {
+        for(int tick = 0; tick < ticks; ++tick) {
+            for(std::size_t i = 0; i < bodies.size(); ++i) {
+                bodies[i].add_force(force2d(0.0, -10.0 * bodies.get_weights()[i].value));
+            }
+            sleeping.wake_flagged(bodies);
+            auto const positions = bodies.get_positions();
+            auto const velocities = bodies.get_velocities();
+            auto const accelerations = bodies.get_accelerations();
+            sleeping.for_each_awake_run(0, bodies.size(), [&] (std::ptrdiff_t begin, std::ptrdiff_t end) {
+                auto const count = end - begin;
+                hz::physics::integrate_batch(positions.subspan(begin, count), velocities.subspan(begin, count), accelerations.subspan(begin, count), dt);
+                std::fill(accelerations.begin() + begin, accelerations.begin() + end, hz::physics::acceleration2d());
+            });
+            collisions.step(bodies);
+            sleeping.update(bodies, collisions.get_contacts());
+        }
+    };
+
+    auto const add_stack = [] (body_storage2d & bodies, double x, int height) {
+        for(int i = 0; i < height; ++i) {
+            auto box = body2d();
+            box.position = position2d(x, 0.5 + i * 1.0);
+            bodies.push_back(box);
+        }
+    };
+
+    auto bodies = body_storage2d();
+    bodies.push_back(floor);
+    add_stack(bodies, -10.0, 3);
+    add_stack(bodies, 10.0, 3);
+
+    auto collisions = collision_system(2.0);
+    auto sleeping = sleep_system();
+    simulate(bodies, collisions, sleeping, 1);
+    REQUIRE(sleeping.get_awake_count() == 6);
+    REQUIRE(!bodies[0].is_awake());
+
+    simulate(bodies, collisions, sleeping, 300);
+
+    SECTION("Resting stacks fall asleep and stay put") {
+        REQUIRE(sleeping.get_awake_count() == 0);
+        auto const resting = bodies.get_positions();
+        auto const positions = std::vector<position2d>(resting.begin(), resting.end());
+        simulate(bodies, collisions, sleeping, 60);
+        for(std::size_t i = 0; i < bodies.size(); ++i) {
+            REQUIRE(bodies.get_positions()[i].value == positions[i].value);
+            REQUIRE(!bodies[i].is_awake());
+        }
+        REQUIRE(bodies.get_accelerations()[1].value == hz::math::vector2d());
+    }
+
+    SECTION("Waking one body wakes its island only") {
+        bodies[2].wake();
+        bodies[2].wake();
+        REQUIRE(bodies.get_woken().get().size() == 1);
+        simulate(bodies, collisions, sleeping, 1);
+        REQUIRE(bodies.get_woken().get().empty());
+        for(std::size_t i = 1; i <= 3; ++i) {
+            REQUIRE(bodies[i].is_awake());
+        }
+        auto const active = sleeping.get_active();
+        REQUIRE(std::vector<std::uint32_t>(active.begin(), active.end()) == std::vector<std::uint32_t>{1, 2, 3});
+        for(std::size_t i = 4; i <= 6; ++i) {
+            REQUIRE(!bodies[i].is_awake());
+        }
+        REQUIRE(!bodies[0].is_awake());
+
+        simulate(bodies, collisions, sleeping, 60);
+        REQUIRE(sleeping.get_awake_count() == 0);
+    }
+
+    SECTION("A falling body wakes the island it lands on") {
+        auto box = body2d();
+        box.position = position2d(10.0, 5.0);
+        box.velocity = velocity2d(0.0, -5.0);
+        bodies.push_back(box);
+
+        auto woken = false;
+        for(int tick = 0; tick < 60 && !woken; ++tick) {
+            simulate(bodies, collisions, sleeping, 1);
+            woken = bodies[6].is_awake();
+        }
+        REQUIRE(woken);
+        REQUIRE(bodies[4].is_awake());
+        REQUIRE(!bodies[1].is_awake());
+
+        simulate(bodies, collisions, sleeping, 300);
+        REQUIRE(sleeping.get_awake_count() == 0);
+        REQUIRE(bodies.get_positions()[7].value.y == Approx(3.5).margin(0.1));
+    }
+}